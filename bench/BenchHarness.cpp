@@ -0,0 +1,136 @@
+#include "BenchHarness.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+void BenchSuite::add(const std::string& name, const std::string& params, int opsPerIteration, Function function) {
+    cases.push_back({name, params, opsPerIteration, std::move(function)});
+}
+
+void BenchSuite::run(const std::string& filter, double minTimeMs) {
+    const double minTimeNs = minTimeMs * 1e6;
+
+    std::cout << std::left << std::setw(28) << "benchmark" << std::setw(28) << "params"
+              << std::right << std::setw(12) << "ns/op" << std::setw(16) << "ops/s"
+              << std::setw(12) << "allocs/it" << std::endl;
+
+    for (const Case& bench : cases) {
+        if (bench.name.find(filter) == std::string::npos) continue;
+
+        // Grow the iteration count tenfold until a run takes a measurable
+        // share of the minimum time, then scale it to fill the minimum
+        Uint64 iterations = 1;
+        while (true) {
+            Stopwatch watch;
+            bench.function(iterations, watch);
+            if (watch.getElapsedNs() >= minTimeNs / 10 || iterations >= (1ull << 32)) {
+                double scaled = iterations * minTimeNs / std::max(watch.getElapsedNs(), 1.0);
+                iterations = std::max<Uint64>(static_cast<Uint64>(scaled), 1);
+                break;
+            }
+            iterations *= 10;
+        }
+
+        std::vector<double> samples;
+        Uint64 allocated = 0;
+        for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+            Stopwatch watch;
+            bench.function(iterations, watch);
+            samples.push_back(watch.getElapsedNs() / (static_cast<double>(iterations) * bench.opsPerIteration));
+            allocated += watch.getAllocations();
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.name = bench.name;
+        result.params = bench.params;
+        result.iterations = iterations;
+        result.nsPerOp = samples[REPETITIONS / 2];
+        result.opsPerSecond = result.nsPerOp > 0.0 ? 1e9 / result.nsPerOp : 0.0;
+        result.allocationsPerIteration = static_cast<double>(allocated) / (static_cast<double>(iterations) * REPETITIONS);
+        results.push_back(result);
+
+        std::cout << std::left << std::setw(28) << result.name << std::setw(28) << result.params
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(12) << result.nsPerOp
+                  << std::setprecision(0) << std::setw(16) << result.opsPerSecond
+                  << std::setprecision(2) << std::setw(12) << result.allocationsPerIteration << std::endl;
+    }
+}
+
+bool BenchSuite::writeJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+
+#ifdef PF_FIXED_POINT
+    const char* scalar = "fixed";
+#else
+    const char* scalar = "float";
+#endif
+#ifdef PF_PROFILE
+    const char* profile = "true";
+#else
+    const char* profile = "false";
+#endif
+
+    file << "{\"scalar\": \"" << scalar << "\", \"profile\": " << profile << ", \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        file << (i == 0 ? "\n" : ",\n") << std::setprecision(6)
+             << "{\"name\": \"" << result.name << "\", \"params\": \"" << result.params
+             << "\", \"iterations\": " << result.iterations
+             << ", \"ns_per_op\": " << result.nsPerOp
+             << ", \"ops_per_second\": " << result.opsPerSecond
+             << ", \"allocations_per_iteration\": " << result.allocationsPerIteration << "}";
+    }
+    file << "\n]}\n";
+
+    std::cout << "Wrote results to " << path << std::endl;
+    return true;
+}
+
+// Text of a string field in one of writeJson's benchmark lines
+static std::string stringField(const std::string& line, const std::string& key) {
+    std::string marker = "\"" + key + "\": \"";
+    size_t start = line.find(marker);
+    if (start == std::string::npos) return "";
+    start += marker.size();
+    return line.substr(start, line.find('"', start) - start);
+}
+
+bool BenchSuite::compare(const std::string& baselinePath) const {
+    std::ifstream file(baselinePath);
+    if (!file) {
+        std::cerr << "Failed to open " << baselinePath << std::endl;
+        return false;
+    }
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    const std::string nsMarker = "\"ns_per_op\": ";
+    while (std::getline(file, line)) {
+        size_t ns = line.find(nsMarker);
+        if (ns == std::string::npos) continue;
+        std::string key = stringField(line, "name") + " " + stringField(line, "params");
+        baseline[key] = std::atof(line.c_str() + ns + nsMarker.size());
+    }
+
+    std::cout << std::endl << "Against " << baselinePath << ":" << std::endl;
+    for (const BenchResult& result : results) {
+        auto found = baseline.find(result.name + " " + result.params);
+        std::cout << std::left << std::setw(28) << result.name << std::setw(28) << result.params << std::right;
+        if (found == baseline.end() || found->second <= 0.0) {
+            std::cout << std::setw(12) << "new" << std::endl;
+            continue;
+        }
+        double change = 100.0 * (result.nsPerOp - found->second) / found->second;
+        std::cout << std::fixed << std::setprecision(1) << std::setw(11) << std::showpos << change
+                  << std::noshowpos << "%" << std::endl;
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+
+// Small self-contained harness behind the microbench target. Each case
+// runs its operation a given number of times and brackets the part being
+// measured with a Stopwatch; the suite picks an iteration count that fills
+// the minimum run time, repeats the run and keeps the median. Heap
+// allocations made on the benchmark's thread are counted while the
+// stopwatch runs.
+
+class Stopwatch {
+public:
+    void start() {
+        allocationsAtStart = allocationCount();
+        began = std::chrono::steady_clock::now();
+    }
+    void stop() {
+        auto now = std::chrono::steady_clock::now();
+        elapsed += std::chrono::duration<double, std::nano>(now - began).count();
+        allocations += allocationCount() - allocationsAtStart;
+    }
+
+    double getElapsedNs() const { return elapsed; }
+    Uint64 getAllocations() const { return allocations; }
+
+private:
+    std::chrono::steady_clock::time_point began;
+    double elapsed = 0.0;
+    Uint64 allocationsAtStart = 0;
+    Uint64 allocations = 0;
+};
+
+struct BenchResult {
+    std::string name;     // Operation, e.g. "EnemyPool::collide"
+    std::string params;   // e.g. "enemies=1000 platforms=100"
+    Uint64 iterations;
+    double nsPerOp;
+    double opsPerSecond;
+    double allocationsPerIteration;
+};
+
+class BenchSuite {
+public:
+    // Runs the operation iterations times, timing it with the stopwatch
+    using Function = std::function<void(Uint64 iterations, Stopwatch& watch)>;
+
+    static constexpr int REPETITIONS = 5;
+
+    // opsPerIteration is how many operations one iteration stands for, such
+    // as the enemy count for a whole-pool update, so ns/op is per enemy
+    void add(const std::string& name, const std::string& params, int opsPerIteration, Function function);
+
+    // Run the cases whose name contains filter, printing a row for each
+    void run(const std::string& filter, double minTimeMs);
+
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+    // Results as JSON, one benchmark object per line
+    bool writeJson(const std::string& path) const;
+
+    // Print the change in ns/op against a file written by writeJson
+    bool compare(const std::string& baselinePath) const;
+
+private:
+    struct Case {
+        std::string name;
+        std::string params;
+        int opsPerIteration;
+        Function function;
+    };
+
+    std::vector<Case> cases;
+    std::vector<BenchResult> results;
+};
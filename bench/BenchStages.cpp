@@ -0,0 +1,41 @@
+#include "BenchStages.h"
+#include <algorithm>
+#include "EnemyPool.h"
+
+Stage buildTowerStage(int platformCount, int rowSpacing, int width, bool withGround) {
+    Stage stage;
+    stage.width = width;
+
+    int perRow = std::max(1, width / 200);
+    int rowCount = withGround ? std::max(0, platformCount - 1) : platformCount;
+    int rowsNeeded = (rowCount + perRow - 1) / perRow;
+    if (withGround) {
+        stage.platforms.push_back(Platform(0, (rowsNeeded + 1) * rowSpacing, width, 50));
+        stage.height = (rowsNeeded + 2) * rowSpacing;
+    } else {
+        stage.height = (rowsNeeded + 1) * rowSpacing;
+    }
+
+    for (int i = 0; i < rowCount; i++) {
+        int row = i / perRow;
+        int column = i % perRow;
+        int offset = (row % 2) * 100;
+        int top = (rowsNeeded - row) * rowSpacing;
+        stage.platforms.push_back(Platform(column * 200 + offset - 50, top, 150, 20));
+        if (i % 10 == 0) {
+            stage.enemySpawns.push_back({column * 200 + offset, top - 60});
+        }
+    }
+    return stage;
+}
+
+Stage buildCrowdStage(int enemyCount) {
+    Stage stage = buildTowerStage(1 + 22 * 16, 100, 3200, true);
+    stage.rebuild();
+    stage.playerSpawn = {stage.width / 2, stage.height - 200};
+    stage.enemySpawns.clear();
+    for (int i = 0; i < enemyCount; i++) {
+        stage.enemySpawns.push_back({(i * 37) % (stage.width - EnemyPool::WIDTH), (i * 53) % (stage.height - 100)});
+    }
+    return stage;
+}
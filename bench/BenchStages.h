@@ -0,0 +1,17 @@
+#pragma once
+#include "Stage.h"
+
+// Stages the benchmarks share, so every bench measures on the same layouts.
+
+// Stage width px wide with rows of 150 px platforms, one every 200 px and
+// every other row shifted 100 px, stacked rowSpacing px apart from the
+// bottom up; 100 px apart they're close enough for enemies to jump
+// between. withGround puts a floor under them all as the first of the
+// platformCount platforms. Every tenth platform gets an enemy spawn on it.
+// Derived data isn't built, so benches can time rebuild() themselves.
+Stage buildTowerStage(int platformCount, int rowSpacing = 100, int width = 800, bool withGround = false);
+
+// A 3200 x 2400 tower with a ground, wide and tall enough to spread
+// enemyCount enemies over many combat bands, one spawn per enemy. Built
+// and ready to play.
+Stage buildCrowdStage(int enemyCount);
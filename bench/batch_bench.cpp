@@ -0,0 +1,56 @@
+// Throughput of BatchRunner as the thread count grows.
+// Usage: batch_bench [matches] [max frames]
+#include "BatchRunner.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int matches = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int maxFrames = argc > 2 ? std::atoi(argv[2]) : 3600;
+
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (hardwareThreads <= 0) hardwareThreads = 1;
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    std::cout << "threads   matches/s   speedup   efficiency" << std::endl;
+    double baseline = 0.0;
+    std::vector<MatchResult> results;
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        BatchRunner runner(pool);
+
+        auto start = std::chrono::steady_clock::now();
+        results = runner.run(matches, maxFrames, 1);
+        auto end = std::chrono::steady_clock::now();
+
+        double rate = matches / std::chrono::duration<double>(end - start).count();
+        if (baseline == 0.0) baseline = rate;
+        std::cout << threads << "   " << rate << "   " << rate / baseline << "x   "
+                  << 100.0 * rate / baseline / threads << "%" << std::endl;
+    }
+
+    // Summary of the last batch (identical for every thread count)
+    int playerWins = 0;
+    long long frames = 0, hitsLanded = 0, hitsTaken = 0;
+    for (const MatchResult& result : results) {
+        if (result.winner == MatchResult::Winner::PLAYER) playerWins++;
+        frames += result.frames;
+        hitsLanded += result.hitsLanded;
+        hitsTaken += result.hitsTaken;
+    }
+    std::cout << "Player wins: " << playerWins << "/" << matches
+              << "  mean frames: " << frames / static_cast<double>(matches)
+              << "  mean hits landed: " << hitsLanded / static_cast<double>(matches)
+              << "  mean hits taken: " << hitsTaken / static_cast<double>(matches) << std::endl;
+
+    return 0;
+}
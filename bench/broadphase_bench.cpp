@@ -0,0 +1,55 @@
+// Compares platform collision through the PlatformGrid broadphase against
+// a full scan (a grid with a single cell) on tall stages with hundreds of
+// platforms.
+// Usage: broadphase_bench [ticks] [enemies]
+#include "BenchStages.h"
+#include "EnemyPool.h"
+#include "Player.h"
+#include "Stage.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static double runTicks(const Stage& stage, int enemyCount, int ticks) {
+    Player player(400, stage.height / 2);
+    EnemyPool enemies(enemyCount);
+    FrameArena scratch;
+    for (int i = 0; i < enemyCount; i++) {
+        enemies.spawn((i * 37) % 760, (i * 7919) % stage.height);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; t++) {
+        player.update(stage);
+        SDL_Rect target = player.getRect();
+        enemies.update(stage, &target, 1, t, scratch);
+        scratch.reset();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / ticks;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::atoi(argv[1]) : 300;
+    int enemyCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    const int platformCounts[] = {4, 100, 250, 500, 1000};
+
+    std::cout << "platforms   full scan ms/tick   grid ms/tick   speedup" << std::endl;
+    for (int platformCount : platformCounts) {
+        // Rows 150 px apart
+        Stage fullScan = buildTowerStage(platformCount, 150);
+        fullScan.rebuild();
+        fullScan.grid.build(fullScan.platforms, 1 << 20);
+        Stage grid = buildTowerStage(platformCount, 150);
+        grid.rebuild();
+
+        double scanMs = runTicks(fullScan, enemyCount, ticks);
+        double gridMs = runTicks(grid, enemyCount, ticks);
+        std::cout << platformCount << "   " << scanMs << "   " << gridMs << "   "
+                  << scanMs / gridMs << "x" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Measures Combat::resolve with thousands of attackers swinging at once,
+// against testing every hitbox against every hurtbox.
+// Usage: combat_bench [frames]
+#include "Combat.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct Fighter {
+    SDL_Rect body;
+    Team team;
+};
+
+// Two teams mixed over an area that grows with the count, so each fighter
+// overlaps a handful of others like in a crowded brawl
+static std::vector<Fighter> buildFighters(int count) {
+    std::vector<Fighter> fighters;
+    int columns = 1;
+    while (columns * columns < count) columns++;
+    Uint32 seed = 12345;
+    for (int i = 0; i < count; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        int x = (i % columns) * 60 + static_cast<int>(seed % 40);
+        int y = (i / columns) * 70 + static_cast<int>((seed >> 8) % 30);
+        fighters.push_back({{x, y, 40, 60}, i % 2 ? Team::ENEMIES : Team::PLAYERS});
+    }
+    return fighters;
+}
+
+static void publish(Combat& combat, const std::vector<Fighter>& fighters) {
+    combat.beginFrame();
+    for (int i = 0; i < static_cast<int>(fighters.size()); i++) {
+        const SDL_Rect& body = fighters[i].body;
+        combat.addHurtbox(body, i, i, fighters[i].team);
+        SDL_Rect attack = {i % 2 ? body.x - 60 : body.x + body.w, body.y, 60, body.h};
+        combat.addHitbox(attack, i, 0, fighters[i].team);
+    }
+}
+
+// Reference: every hitbox against every hurtbox, no hit-once tracking
+static int bruteForce(const std::vector<Fighter>& fighters) {
+    int hits = 0;
+    for (int a = 0; a < static_cast<int>(fighters.size()); a++) {
+        const SDL_Rect& body = fighters[a].body;
+        SDL_Rect attack = {a % 2 ? body.x - 60 : body.x + body.w, body.y, 60, body.h};
+        for (int v = 0; v < static_cast<int>(fighters.size()); v++) {
+            if (fighters[v].team == fighters[a].team) continue;
+            if (SDL_HasIntersection(&attack, &fighters[v].body)) hits++;
+        }
+    }
+    return hits;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 100;
+
+    const int counts[] = {100, 1000, 5000, 20000};
+
+    std::cout << "attackers   first frame hits   sweep ms/frame   ns/box   brute force ms/frame   matches" << std::endl;
+    for (int count : counts) {
+        std::vector<Fighter> fighters = buildFighters(count);
+        Combat combat;
+        std::vector<HitEvent> hits;
+        FrameArena scratch;
+
+        // The first frame lands every hit, later frames of the same attacks
+        // land none but still pay for the sweep
+        publish(combat, fighters);
+        combat.resolve(hits, scratch);
+        scratch.reset();
+        int firstHits = static_cast<int>(hits.size());
+
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            publish(combat, fighters);
+            hits.clear();
+            combat.resolve(hits, scratch);
+            scratch.reset();
+        }
+        auto end = std::chrono::steady_clock::now();
+        double sweepMs = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+        // Brute force is quadratic, only time it where it finishes
+        std::cout << count << "   " << firstHits << "   " << sweepMs << "   "
+                  << sweepMs * 1e6 / (count * 2) << "   ";
+        if (count <= 5000) {
+            start = std::chrono::steady_clock::now();
+            int bruteHits = bruteForce(fighters);
+            end = std::chrono::steady_clock::now();
+            std::cout << std::chrono::duration<double, std::milli>(end - start).count() << "   "
+                      << (bruteHits == firstHits ? "yes" : "no") << std::endl;
+        } else {
+            std::cout << "-   -" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Measures EnemyPool::update cost as the number of enemies grows, with AI
+// level of detail off and on.
+// Usage: enemy_pool_bench [ticks]
+#include "EnemyPool.h"
+#include "Stage.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static double runTicks(const Stage& stage, int count, int ticks, int lodInterval) {
+    SDL_Rect target = {400, 300, 50, 50};
+    EnemyPool enemies(count);
+    FrameArena scratch;
+    enemies.setAILevelOfDetail(Scalar(200), lodInterval);
+    for (int i = 0; i < count; i++) {
+        // Spread enemies across the stage so they land on different platforms
+        enemies.spawn((i * 37) % 760, (i * 53) % 500);
+    }
+
+    // Warm up so caches and branch predictors settle
+    for (int t = 0; t < 10; t++) {
+        enemies.update(stage, &target, 1, t, scratch);
+        scratch.reset();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; t++) {
+        enemies.update(stage, &target, 1, t, scratch);
+        scratch.reset();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / ticks;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::atoi(argv[1]) : 600;
+
+    Stage stage = Stage::builtIn();
+
+    const int counts[] = {1, 10, 100, 1000, 5000, 10000, 20000};
+    const double budgetMs = 1000.0 / 60.0;
+
+    std::cout << "enemies   ms/tick   ns/enemy   ms/tick (AI LOD 1/4)   fits 60 Hz" << std::endl;
+    for (int count : counts) {
+        double ms = runTicks(stage, count, ticks, 1);
+        double lodMs = runTicks(stage, count, ticks, 4);
+        std::cout << count << "   " << ms << "   " << ms * 1e6 / count << "   " << lodMs << "   "
+                  << (ms < budgetMs ? "yes" : "no") << std::endl;
+    }
+
+    return 0;
+}
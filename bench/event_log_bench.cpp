@@ -0,0 +1,71 @@
+// Measures the cost of recording a game event from one or more threads
+// while the writer thread drains to a file, against printing the same line
+// with std::endl.
+// Usage: event_log_bench [events per thread] [output file]
+#include "EventLog.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Record in bursts the size of a busy tick, pausing between them like a
+// 60 Hz simulation would so the writer can keep up
+static double recordNs(EventLog& log, int threadCount, int events) {
+    const int burst = 256;
+    std::vector<double> perThread(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&log, &perThread, t, events] {
+            double ns = 0.0;
+            for (int done = 0; done < events; done += burst) {
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < burst; i++) {
+                    log.record<EventType::DAMAGE>(done + i, t, 0, 5, 4);
+                }
+                auto end = std::chrono::steady_clock::now();
+                ns += std::chrono::duration<double, std::nano>(end - start).count();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            perThread[t] = ns / events;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double total = 0.0;
+    for (double ns : perThread) {
+        total += ns;
+    }
+    return total / threadCount;
+}
+
+int main(int argc, char* argv[]) {
+    int events = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::string path = argc > 2 ? argv[2] : "event_log_bench.txt";
+
+    std::cout << "threads   ns/event   dropped" << std::endl;
+    for (int threadCount : {1, 2, 4}) {
+        EventLog log;
+        if (!log.start(path)) return 1;
+        double ns = recordNs(log, threadCount, events);
+        Uint32 dropped = log.getDroppedCount();
+        log.stop();
+        std::cout << threadCount << "   " << ns << "   " << dropped << std::endl;
+    }
+
+    // The old way: format and flush on the simulation thread
+    std::ofstream file(path);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events; i++) {
+        file << "Enemy hit! Health before: " << 5 << ", Health after: " << 4 << std::endl;
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "std::endl   " << std::chrono::duration<double, std::nano>(end - start).count() / events
+              << "   0" << std::endl;
+
+    return 0;
+}
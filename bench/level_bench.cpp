@@ -0,0 +1,65 @@
+// Measures switching stages: building one from its platforms (grid and
+// navigation graph) against mapping a compiled level and taking its
+// prebuilt grid and links, on tall stages with up to thousands of
+// platforms.
+// Usage: level_bench [file]
+#include "BenchStages.h"
+#include "Level.h"
+#include "Stage.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "level_bench.level";
+
+    const int platformCounts[] = {4, 100, 1000, 5000};
+
+    std::cout << "platforms   file KB   grid build ms   nav build ms   open ms   load ms" << std::endl;
+    for (int platformCount : platformCounts) {
+        Stage source = buildTowerStage(platformCount);
+
+        auto start = std::chrono::steady_clock::now();
+        source.grid.build(source.platforms);
+        double gridMs = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        source.rebuild();
+        double navMs = elapsedMs(start) - gridMs;
+
+        if (!Level::save(path, source)) return 1;
+
+        Level level;
+        start = std::chrono::steady_clock::now();
+        if (!level.open(path)) return 1;
+        double openMs = elapsedMs(start);
+
+        Stage loaded;
+        start = std::chrono::steady_clock::now();
+        if (!loaded.load(level)) return 1;
+        double loadMs = elapsedMs(start);
+        const LevelHeader& header = level.getHeader();
+
+        // Sanity check: the mapped grid answers like the built one
+        std::vector<int> expected, actual;
+        SDL_Rect area = {0, 0, 800, source.height};
+        source.grid.query(area, expected);
+        loaded.grid.query(area, actual);
+        if (expected != actual || loaded.nav.getLinkCount() != source.nav.getLinkCount()) {
+            std::cerr << "Loaded stage differs at " << platformCount << " platforms" << std::endl;
+            return 1;
+        }
+
+        std::cout << platformCount << "   " << (header.navLinksOffset + header.navLinkCount * sizeof(LevelNavLink)) / 1024.0 << "   "
+                  << gridMs << "   " << navMs << "   " << openMs << "   " << loadMs << std::endl;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
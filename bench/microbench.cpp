@@ -0,0 +1,301 @@
+// Microbenchmarks of the simulation hot paths - player and enemy updates,
+// platform collision, enemy AI and hit resolution - over a range of
+// platform and entity counts, without a window. Reports ns per operation,
+// operations per second and heap allocations per iteration, and can write
+// the results as JSON and compare them against an earlier run.
+// Usage: microbench [--filter text] [--min-time ms] [--json file] [--compare file]
+#include "BenchHarness.h"
+#include "BenchStages.h"
+#include "Combat.h"
+#include "EnemyPool.h"
+#include "Input.h"
+#include "Player.h"
+#include "Stage.h"
+#include "World.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// The shared tower of platforms with a ground under them all. Four
+// platforms give the built-in stage instead. Collision-only benchmarks can
+// skip the navigation graph.
+static std::shared_ptr<Stage> buildStage(int platformCount, bool withNav = true) {
+    if (platformCount <= 4) {
+        return std::make_shared<Stage>(Stage::builtIn());
+    }
+    auto stage = std::make_shared<Stage>(buildTowerStage(platformCount, 100, 800, true));
+    if (withNav) {
+        stage->rebuild();
+    } else {
+        stage->grid.build(stage->platforms);
+    }
+    return stage;
+}
+
+static std::shared_ptr<EnemyPool> buildEnemies(const Stage& stage, int count) {
+    auto enemies = std::make_shared<EnemyPool>(count);
+    for (int i = 0; i < count; i++) {
+        enemies->spawn((i * 37) % (stage.width - EnemyPool::WIDTH), (i * 53) % (stage.height - 100));
+    }
+
+    // Let everyone land so the timed ticks see settled enemies
+    SDL_Rect target = {stage.width / 2, stage.height - 200, 50, 50};
+    FrameArena scratch;
+    for (int t = 0; t < 60; t++) {
+        enemies->update(stage, &target, 1, t, scratch);
+        scratch.reset();
+    }
+    return enemies;
+}
+
+static std::string params(const char* name, int value) {
+    return std::string(name) + "=" + std::to_string(value);
+}
+
+static std::string params(const char* first, int firstValue, const char* second, int secondValue) {
+    return params(first, firstValue) + " " + params(second, secondValue);
+}
+
+static void addPlayerBenchmarks(BenchSuite& suite) {
+    for (int platformCount : {4, 100, 1000}) {
+        auto stage = buildStage(platformCount);
+        auto player = std::make_shared<Player>(stage->width / 2, stage->height - 300);
+        auto script = std::make_shared<InputScript>(1);
+
+        suite.add("Player::update", params("platforms", platformCount), 1,
+                  [stage, player, script](Uint64 iterations, Stopwatch& watch) {
+            watch.start();
+            for (Uint64 i = 0; i < iterations; i++) {
+                player->handleInput(script->next());
+                player->update(*stage);
+            }
+            watch.stop();
+        });
+    }
+}
+
+static void addEnemyBenchmarks(BenchSuite& suite) {
+    auto smallStage = buildStage(4);
+    for (int count : {1, 100, 1000, 10000}) {
+        auto enemies = buildEnemies(*smallStage, count);
+        auto frame = std::make_shared<int>(0);
+        auto scratch = std::make_shared<FrameArena>();
+        SDL_Rect target = {400, 300, 50, 50};
+
+        // Whole ticks, then the AI and collision phases on their own
+        suite.add("EnemyPool::update", params("enemies", count), count,
+                  [smallStage, enemies, frame, scratch, target](Uint64 iterations, Stopwatch& watch) {
+            watch.start();
+            for (Uint64 i = 0; i < iterations; i++) {
+                enemies->update(*smallStage, &target, 1, (*frame)++, *scratch);
+                scratch->reset();
+            }
+            watch.stop();
+        });
+
+        suite.add("EnemyPool::think", params("enemies", count), count,
+                  [smallStage, enemies, frame, scratch, target](Uint64 iterations, Stopwatch& watch) {
+            for (Uint64 i = 0; i < iterations; i++) {
+                enemies->beginTick((*frame)++);
+                watch.start();
+                enemies->think(*smallStage, &target, 1, *scratch);
+                watch.stop();
+                scratch->reset();
+                enemies->collide(*smallStage);
+                enemies->updateTimers();
+            }
+        });
+    }
+
+    for (int platformCount : {4, 1000}) {
+        auto stage = platformCount == 4 ? smallStage : buildStage(platformCount);
+        for (int count : {100, 10000}) {
+            auto enemies = buildEnemies(*stage, count);
+            auto frame = std::make_shared<int>(0);
+            auto scratch = std::make_shared<FrameArena>();
+            SDL_Rect target = {stage->width / 2, stage->height - 200, 50, 50};
+
+            suite.add("EnemyPool::collide", params("enemies", count, "platforms", platformCount), count,
+                      [stage, enemies, frame, scratch, target](Uint64 iterations, Stopwatch& watch) {
+                for (Uint64 i = 0; i < iterations; i++) {
+                    enemies->beginTick((*frame)++);
+                    enemies->think(*stage, &target, 1, *scratch);
+                    scratch->reset();
+                    watch.start();
+                    enemies->collide(*stage);
+                    watch.stop();
+                    enemies->updateTimers();
+                }
+            });
+        }
+    }
+
+    // Crowds standing still, as attacking enemies do: every one asleep on
+    // its platform, so a tick's collide only cancels gravity
+    for (int count : {100, 10000}) {
+        auto enemies = buildEnemies(*smallStage, count);
+        std::vector<EnemyState> states(count);
+        enemies->saveState(states.data(), count);
+        for (EnemyState& state : states) {
+            state.velocityX = 0;
+        }
+        enemies->loadState(states.data(), count);
+        auto frame = std::make_shared<int>(0);
+
+        suite.add("EnemyPool::collide", params("enemies", count, "idle", 1), count,
+                  [smallStage, enemies, frame](Uint64 iterations, Stopwatch& watch) {
+            for (Uint64 i = 0; i < iterations; i++) {
+                enemies->beginTick((*frame)++);
+                watch.start();
+                enemies->collide(*smallStage);
+                watch.stop();
+                enemies->updateTimers();
+            }
+        });
+    }
+}
+
+static void addCollisionBenchmarks(BenchSuite& suite) {
+    for (int platformCount : {4, 100, 1000, 5000}) {
+        auto stage = buildStage(platformCount, false);
+        auto nearby = std::make_shared<std::vector<int>>();
+        nearby->reserve(platformCount);
+
+        // Broadphase query and narrow phase for one body-sized area, at
+        // positions spread over the stage
+        suite.add("PlatformGrid::query", params("platforms", platformCount), 1,
+                  [stage, nearby](Uint64 iterations, Stopwatch& watch) {
+            int hits = 0;
+            watch.start();
+            for (Uint64 i = 0; i < iterations; i++) {
+                SDL_Rect body = {static_cast<int>(i * 37 % 760), static_cast<int>(i * 53 % stage->height), 40, 60};
+                SDL_Rect area = {body.x - 40, body.y - 60, 120, 180};
+                stage->grid.query(area, *nearby);
+                for (int p : *nearby) {
+                    SDL_Rect rect = stage->platforms[p].getRect();
+                    hits += SDL_HasIntersection(&body, &rect) ? 1 : 0;
+                }
+            }
+            watch.stop();
+            volatile int sink = hits;  // Keeps the narrow phase from being optimized out
+            (void)sink;
+        });
+    }
+}
+
+static void addCombatBenchmarks(BenchSuite& suite) {
+    for (int count : {100, 1000, 10000}) {
+        // Two teams mixed over an area that grows with the count
+        auto bodies = std::make_shared<std::vector<SDL_Rect>>();
+        int columns = 1;
+        while (columns * columns < count) columns++;
+        for (int i = 0; i < count; i++) {
+            bodies->push_back({(i % columns) * 60 + (i * 7) % 40, (i / columns) * 70 + (i * 13) % 30, 40, 60});
+        }
+        auto combat = std::make_shared<Combat>();
+        auto hits = std::make_shared<std::vector<HitEvent>>();
+        auto scratch = std::make_shared<FrameArena>();
+
+        suite.add("Combat::resolve", params("fighters", count), count,
+                  [bodies, combat, hits, scratch](Uint64 iterations, Stopwatch& watch) {
+            for (Uint64 i = 0; i < iterations; i++) {
+                combat->beginFrame();
+                for (int f = 0; f < static_cast<int>(bodies->size()); f++) {
+                    const SDL_Rect& body = (*bodies)[f];
+                    Team team = f % 2 ? Team::ENEMIES : Team::PLAYERS;
+                    combat->addHurtbox(body, f, f, team);
+                    combat->addHitbox({f % 2 ? body.x - 60 : body.x + body.w, body.y, 60, body.h}, f, 0, team);
+                }
+                hits->clear();
+                watch.start();
+                combat->resolve(*hits, *scratch);
+                watch.stop();
+                scratch->reset();
+            }
+        });
+    }
+}
+
+static void addWorldBenchmarks(BenchSuite& suite) {
+    auto world = std::make_shared<World>(800, 600);
+    auto script = std::make_shared<InputScript>(1);
+    suite.add("World::step", "level=default", 1, [world, script](Uint64 iterations, Stopwatch& watch) {
+        watch.start();
+        for (Uint64 i = 0; i < iterations; i++) {
+            world->step(script->next());
+        }
+        watch.stop();
+    });
+
+    // Per-tick desync hash over the default level, and over a pool of
+    // enemies on its own
+    suite.add("World::hashState", "level=default", 1, [world](Uint64 iterations, Stopwatch& watch) {
+        Uint64 hash = 0;
+        watch.start();
+        for (Uint64 i = 0; i < iterations; i++) {
+            hash ^= world->hashState();
+        }
+        watch.stop();
+        volatile Uint64 sink = hash;
+        (void)sink;
+    });
+
+    auto stage = buildStage(4);
+    for (int count : {100, 1000}) {
+        auto enemies = buildEnemies(*stage, count);
+        suite.add("EnemyPool::hashState", params("enemies", count), count, [enemies](Uint64 iterations, Stopwatch& watch) {
+            Uint64 hash = 0;
+            watch.start();
+            for (Uint64 i = 0; i < iterations; i++) {
+                StateHash state;
+                enemies->hashState(state);
+                hash ^= state.get();
+            }
+            watch.stop();
+            volatile Uint64 sink = hash;
+            (void)sink;
+        });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    double minTimeMs = 100.0;
+    std::string jsonPath;
+    std::string comparePath;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTimeMs = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            comparePath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    BenchSuite suite;
+    addPlayerBenchmarks(suite);
+    addEnemyBenchmarks(suite);
+    addCollisionBenchmarks(suite);
+    addCombatBenchmarks(suite);
+    addWorldBenchmarks(suite);
+
+    suite.run(filter, minTimeMs);
+
+    if (!jsonPath.empty() && !suite.writeJson(jsonPath)) {
+        return 1;
+    }
+    if (!comparePath.empty() && !suite.compare(comparePath)) {
+        return 1;
+    }
+    return 0;
+}
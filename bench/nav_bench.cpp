@@ -0,0 +1,60 @@
+// Measures navigation graph build time, a full route search and a cached
+// next-link lookup on tall stages with hundreds of platforms.
+// Usage: nav_bench [lookups]
+#include "BenchStages.h"
+#include "EnemyPool.h"
+#include "NavGraph.h"
+#include "Stage.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int lookups = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    const int platformCounts[] = {4, 100, 250, 500, 1000};
+
+    std::cout << "platforms   links   build ms   search us   lookup ns   reachable" << std::endl;
+    for (int platformCount : platformCounts) {
+        Stage stage = buildTowerStage(platformCount);
+
+        auto start = std::chrono::steady_clock::now();
+        stage.rebuild();
+        double buildMs = elapsedUs(start) / 1000.0;
+
+        // Route everything toward the top platform
+        int target = platformCount - 1;
+        std::vector<int> next;
+        FrameArena scratch;
+        start = std::chrono::steady_clock::now();
+        stage.nav.searchTo(target, next, scratch);
+        double searchUs = elapsedUs(start);
+
+        int reachable = 0;
+        for (int p = 0; p < platformCount; p++) {
+            if (p == target || next[p] >= 0) reachable++;
+        }
+
+        scratch.reset();
+
+        PathCache paths;
+        paths.prepare(stage.nav, target, scratch);
+        volatile int sink = 0;  // Keeps the lookups from being optimized out
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; i++) {
+            sink = paths.nextLink(i % platformCount, target);
+        }
+        (void)sink;
+        double lookupNs = elapsedUs(start) * 1000.0 / lookups;
+
+        std::cout << platformCount << "   " << stage.nav.getLinkCount() << "   " << buildMs << "   "
+                  << searchUs << "   " << lookupNs << "   " << reachable << "/" << platformCount << std::endl;
+    }
+
+    return 0;
+}
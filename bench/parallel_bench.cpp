@@ -0,0 +1,62 @@
+// Tick time of a world with thousands of enemies as the thread count grows.
+// That every thread count gives the same results is checked by the
+// parallel_determinism test.
+// Usage: parallel_bench [enemies] [min time ms]
+#include "BenchHarness.h"
+#include "BenchStages.h"
+#include "Input.h"
+#include "ThreadPool.h"
+#include "World.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int enemyCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    double minTimeMs = argc > 2 ? std::atof(argv[2]) : 500.0;
+
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (hardwareThreads <= 0) hardwareThreads = 1;
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    Stage stage = buildCrowdStage(enemyCount);
+    std::cout << enemyCount << " enemies, " << stage.platforms.size() << " platforms" << std::endl;
+
+    // The calling thread works too, so one thread needs no pool
+    std::vector<std::unique_ptr<ThreadPool>> pools;
+    for (int threads : threadCounts) {
+        pools.push_back(threads > 1 ? std::make_unique<ThreadPool>(threads - 1) : nullptr);
+    }
+
+    BenchSuite suite;
+    for (size_t c = 0; c < threadCounts.size(); c++) {
+        auto world = std::make_shared<World>(stage, Archetype::BRAWLER, enemyCount);
+        world->setThreadPool(pools[c].get());
+        auto script = std::make_shared<InputScript>(1);
+        std::string params = "threads=" + std::to_string(threadCounts[c]) + " enemies=" + std::to_string(enemyCount);
+        suite.add("World::step", params, 1, [world, script](Uint64 iterations, Stopwatch& watch) {
+            watch.start();
+            for (Uint64 i = 0; i < iterations; i++) {
+                world->step(script->next());
+            }
+            watch.stop();
+        });
+    }
+    suite.run("", minTimeMs);
+
+    std::cout << std::endl << "threads   speedup" << std::endl;
+    const std::vector<BenchResult>& results = suite.getResults();
+    for (size_t c = 0; c < threadCounts.size(); c++) {
+        std::cout << threadCounts[c] << "   " << results[0].nsPerOp / results[c].nsPerOp << "x" << std::endl;
+    }
+    return 0;
+}
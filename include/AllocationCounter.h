@@ -0,0 +1,10 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// Heap allocations made by the calling thread so far. Linking this in
+// replaces the global operator new with one that counts per thread, so
+// counting never contends between threads; array and nothrow forms
+// forward to it by default and over-aligned allocations aren't counted.
+// Only PF_ALLOCATION_CHECK builds and the benchmarks link it, through the
+// allocation_counter library.
+Uint64 allocationCount();
@@ -0,0 +1,33 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "ThreadPool.h"
+
+struct MatchResult {
+    enum class Winner : Uint8 {
+        PLAYER,   // Every enemy defeated
+        ENEMIES   // Time ran out with enemies still standing
+    };
+
+    Winner winner;
+    int frames;
+    int hitsLanded;
+    int hitsTaken;
+};
+
+// Plays many independent headless matches across a thread pool. Each
+// match writes only its own result slot, so workers never contend.
+class BatchRunner {
+public:
+    explicit BatchRunner(ThreadPool& pool) : pool(pool) {}
+
+    // Play count matches with scripted input, match i using seed
+    // baseSeed + i, each lasting at most maxFrames
+    std::vector<MatchResult> run(int count, int maxFrames, Uint32 baseSeed);
+
+    // Play a single match on the calling thread
+    static MatchResult playMatch(Uint32 seed, int maxFrames);
+
+private:
+    ThreadPool& pool;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Scalar.h"
+#include "Stage.h"
+
+// Sides of a body that ended up against a platform during a move
+enum ContactSide : Uint8 {
+    CONTACT_FLOOR   = 1 << 0,
+    CONTACT_CEILING = 1 << 1,
+    CONTACT_LEFT    = 1 << 2,
+    CONTACT_RIGHT   = 1 << 3
+};
+
+// An axis-aligned body moving through the stage, x and y its top-left
+// corner and the velocity in pixels per tick
+struct SweptBody {
+    Scalar x, y;
+    Scalar velX, velY;
+    int width;
+    int height;
+};
+
+struct MoveResult {
+    Uint8 contacts = 0;  // ContactSide bits
+    int floor = -1;      // Platform landed or resting on, -1 when airborne
+};
+
+// Continuous collision against the stage's platforms, shared by the player
+// and the enemies. Each move finds the time of impact against every nearby
+// platform, stops at the earliest, zeroes the velocity into it and slides
+// along it for the rest of the tick, so nothing tunnels however fast it
+// goes. A body that starts a move inside a platform is pushed out along
+// the axis of least overlap first.
+//
+// Bodies standing on a platform can pass it in as their cached contact.
+// While one rests exactly on its top, isn't moving fast, and stays clear
+// of the platform's obstructions (Stage::obstructions), the full move
+// would land straight back on it and slide the rest of the way, so that's
+// done directly without a broadphase query. The result is bit for bit the
+// same either way; a stale contact just takes the full path.
+class CollisionSolver {
+public:
+    // Moves longer than this are split into equal substeps, keeping each
+    // broadphase query to a few grid cells; slower moves run in one step
+    static constexpr int MAX_STEP = 64;
+    // Contacts resolved per step before the rest of the move is dropped
+    static constexpr int MAX_CONTACTS = 4;
+
+    // Move body by one tick of its velocity. restingOn is the platform the
+    // body stood on after its last move, or -1.
+    MoveResult move(const Stage& stage, SweptBody& body, int restingOn = -1);
+
+    // Whether a body resting on platform can take the fast path: exactly
+    // on its top and moving over it by less than a step, clear of anything
+    // else the move could touch
+    static bool canSlideOn(const Stage& stage, const SweptBody& body, int platform);
+
+private:
+    std::vector<int> candidates;  // Broadphase results, reused every move
+
+    void depenetrate(const Stage& stage, SweptBody& body, MoveResult& result) const;
+    void sweep(const Stage& stage, SweptBody& body, Scalar dx, Scalar dy, MoveResult& result) const;
+};
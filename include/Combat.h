@@ -0,0 +1,118 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "FrameArena.h"
+#include "StateHash.h"
+#include "ThreadPool.h"
+#include "WorldState.h"
+
+// Which side an entity fights on; hitboxes only hurt the other teams
+enum class Team : Uint8 {
+    PLAYERS,
+    ENEMIES
+};
+
+// Area an attack hurts this tick. owner is a stable entity id and attack
+// identifies one swing of that owner, the same on every frame it's active.
+struct Hitbox {
+    SDL_Rect rect;
+    Uint32 owner;
+    Uint32 attack;
+    Team team;
+    int damage;
+};
+
+// Area an entity can be hurt in. slot is the entity's current index in its
+// own storage, handed back with hits so they can be applied directly.
+struct Hurtbox {
+    SDL_Rect rect;
+    Uint32 owner;
+    int slot;
+    Team team;
+};
+
+struct HitEvent {
+    Uint32 attacker;
+    Uint32 victim;
+    int victimSlot;
+    Team victimTeam;
+    int damage;
+};
+
+// Combat resolution for one tick. Entities publish their boxes, then
+// resolve() finds every hitbox/hurtbox overlap in a single sweep-and-prune
+// pass along x. Each attack lands at most once per victim, however many
+// frames it stays active.
+class Combat {
+public:
+    // Height of the horizontal bands swept separately
+    static constexpr int BAND_HEIGHT = 128;
+
+    // Box intervals per sweep job when resolving on a thread pool
+    static constexpr int JOB_INTERVALS = 2048;
+
+    // Room for ticks with up to entities fighters, each with a hurtbox and
+    // an attack, so they don't allocate
+    void reserve(int entities);
+
+    // Forget last tick's boxes
+    void beginFrame();
+
+    void addHitbox(const SDL_Rect& rect, Uint32 owner, Uint32 attack, Team team, int damage = 1);
+    void addHurtbox(const SDL_Rect& rect, Uint32 owner, int slot, Team team);
+
+    // Append this tick's new hits to hits, ordered by hitbox then hurtbox
+    // publication order. Working lists come from scratch.
+    void resolve(std::vector<HitEvent>& hits, FrameArena& scratch);
+
+    // Sweep groups of bands as separate jobs on pool, or everything on the
+    // calling thread when pool is null. Each job finds its own overlapping
+    // pairs and the pairs are sorted before use, so the hits come out the
+    // same either way.
+    void setThreadPool(ThreadPool* pool) { threads = pool; }
+
+    int getHitboxCount() const { return static_cast<int>(hitboxes.size()); }
+    int getHurtboxCount() const { return static_cast<int>(hurtboxes.size()); }
+
+    // Hits of attacks still in progress, for snapshots
+    int saveState(HitRecord* records, int maxCount) const;
+    void loadState(const HitRecord* records, int count);
+    void hashState(StateHash& hash) const;
+
+private:
+    // A box's x extent within one band and where to find the box
+    struct Interval {
+        int band;
+        int minX;
+        int maxX;
+        int index;
+        bool isHitbox;
+    };
+
+    std::vector<Hitbox> hitboxes;
+    std::vector<Hurtbox> hurtboxes;
+
+    // Hits landed by attacks that were active last tick, sorted
+    std::vector<HitRecord> landed;
+
+    // One sweep job's boxes still open and the overlapping (hitbox,
+    // hurtbox) index pairs it found
+    struct Sweep {
+        std::vector<int> activeHitboxes;
+        std::vector<int> activeHurtboxes;
+        std::vector<std::pair<int, int>> pairs;
+    };
+
+    // Scratch, reused every tick. A single job sweeps into sweeps[0];
+    // several have their pairs merged into pairs.
+    std::vector<Interval> intervals;
+    std::vector<Sweep> sweeps;
+    std::vector<int> jobStarts;
+    std::vector<std::pair<int, int>> pairs;
+
+    ThreadPool* threads = nullptr;
+
+    void addIntervals(const SDL_Rect& rect, int index, bool isHitbox);
+    void sweep(int begin, int end, Sweep& sweep) const;
+    void testPair(int hitbox, int hurtbox, int band, std::vector<std::pair<int, int>>& out) const;
+};
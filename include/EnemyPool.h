@@ -0,0 +1,217 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Collision.h"
+#include "Platform.h"
+#include "Stage.h"
+#include "RenderSnapshot.h"
+#include "Scalar.h"
+#include "StateHash.h"
+#include "ThreadPool.h"
+#include "WorldState.h"
+#include "Combat.h"
+#include "EventLog.h"
+
+// All enemies in the level, stored as one array per field so the physics
+// passes stream through contiguous memory. update() runs each phase
+// (gravity, AI, move and collide, timers) over the whole pool before the
+// next.
+//
+// The pool has a fixed capacity. Live enemies stay packed at the front of
+// the arrays; each also owns a slot in a side table, and is referred to
+// from outside by handle: its slot plus the slot's generation. Defeated
+// enemies put their slot back on a free list with the generation moved
+// on, so an old handle stops resolving rather than finding whoever reuses
+// the slot.
+class EnemyPool {
+public:
+    // Handles double as enemy ids: generation in the high bits, slot in
+    // the low ones. Generations start at 1, so no handle is ever 0.
+    using Handle = Uint32;
+    static constexpr int SLOT_BITS = 16;
+    static constexpr int MAX_CAPACITY = 1 << SLOT_BITS;
+    static constexpr Uint16 MAX_GENERATION = 0xFFFE;  // Keeps firstEntity + handle from wrapping
+
+    // Enemies per job when the phases run on a thread pool
+    static constexpr int JOB_SIZE = 256;
+
+    static constexpr int WIDTH = 40;
+    static constexpr int HEIGHT = 60;
+    static constexpr Scalar MOVE_SPEED = Scalar(2.0f);
+    static constexpr Scalar GRAVITY = Scalar(0.8f);
+    static constexpr Scalar JUMP_FORCE = Scalar(-15.0f);
+    static constexpr Scalar DETECTION_RANGE = Scalar(300.0f);  // Range at which enemy notices player
+    static constexpr Scalar ATTACK_RANGE = Scalar(60.0f);      // Range at which enemy can attack
+    static constexpr int ATTACK_COOLDOWN = 60;        // Frames between attacks
+    static constexpr int ATTACK_DURATION = 20;        // Frames for attack animation
+    static constexpr int MAX_HEALTH = 5;              // Enemy takes 5 hits to defeat
+
+    // AI state
+    enum class AIState : Uint8 {
+        PATROL,     // Moving back and forth on platform
+        CHASE,      // Pursuing the player
+        ATTACK,     // Performing an attack
+        RETREAT     // Moving away from player when low on health
+    };
+
+    // How enemies move, for building the stage's navigation graph
+    static NavGraph::Profile navProfile() { return {GRAVITY, JUMP_FORCE, MOVE_SPEED, WIDTH, HEIGHT}; }
+
+    // Room for capacity enemies at once, allocated up front so spawning
+    // and despawning never touch the heap
+    explicit EnemyPool(int capacity = 0);
+
+    // Add an enemy and return its index, or -1 when the pool is full.
+    // Indices are only stable until the next update(), which swaps
+    // defeated enemies out of the pool; handles stay the same for an
+    // enemy's whole life.
+    int spawn(int x, int y);
+    void clear();
+    int size() const { return static_cast<int>(x.size()); }
+    int getCapacity() const { return static_cast<int>(slotGeneration.size()); }
+    int aliveCount() const;
+
+    // Index of the enemy handle refers to, or -1 once it has been removed
+    int find(Handle handle) const;
+
+    // Run one tick. Enemies pursue the nearest of the target bodies (one
+    // per player), routing across platforms with the stage's navigation
+    // graph; frame drives AI staggering. Route searches take their working
+    // memory from scratch.
+    void update(const Stage& stage, const SDL_Rect* targets, int targetCount, int frame, FrameArena& scratch);
+
+    // The phases update() runs, in this order, each over the whole pool.
+    // Public so benchmarks can time them one at a time; a tick needs all four.
+    void beginTick(int frame);                                                                     // Drop the defeated, apply gravity
+    void think(const Stage& stage, const SDL_Rect* targets, int targetCount, FrameArena& scratch); // Perception and AI
+    void collide(const Stage& stage);                                                              // Move, sweeping through the platforms
+    void updateTimers();                                                                           // Attack cooldowns and animation
+
+    // AI level of detail: enemies further than nearRange from every target,
+    // or outside the stage, only re-evaluate their AI state every
+    // farInterval frames, staggered across the pool. An interval of 1
+    // turns it off.
+    void setAILevelOfDetail(Scalar nearRange, int farInterval);
+
+    // Record AI state changes as entity firstEntity + id, or nothing when
+    // log is null
+    void setEventLog(EventLog* log, Uint32 firstEntity);
+
+    // Split each phase into jobs of JOB_SIZE enemies on pool, or run
+    // everything on the calling thread when pool is null. Every enemy's
+    // update only touches its own entries, and events are recorded in
+    // pool order after the jobs finish, so results are identical either
+    // way.
+    void setThreadPool(ThreadPool* pool) { threads = pool; }
+
+    // Copy out what the renderer draws for each live enemy
+    void snapshot(std::vector<BodySnapshot>& bodies) const;
+
+    bool isAlive(int i) const { return health[i] > 0; }
+    Handle getId(int i) const { return id[i]; }
+    int getHealth(int i) const { return health[i]; }
+    bool isAttacking(int i) const { return attacking[i] != 0; }
+    SDL_Rect getRect(int i) const;
+    SDL_Rect getAttackRect(int i) const;
+    void applyDamage(int i, int damage);
+
+    // Publish every live enemy's hurtbox and active attack for this tick,
+    // as entity firstEntity + id
+    void publishBoxes(Combat& combat, Uint32 firstEntity, int frame) const;
+
+    // Copy up to maxCount enemies out as plain states and return how many
+    // were written; loadState replaces the whole pool
+    int saveState(EnemyState* states, int maxCount) const;
+    void loadState(const EnemyState* states, int count);
+
+    // Copy the slot table out: each slot's generation and the free list,
+    // returning the slot count. Restoring it after loadState makes later
+    // spawns get the same handles they got the first time round.
+    int saveSlots(Uint16* generations, Uint16* freeList, int maxSlots, int& freeCount) const;
+    void loadSlots(const Uint16* generations, int slotCount, const Uint16* freeList, int freeCount);
+
+    // Feed every EnemyState field of the whole pool into hash, one field
+    // array at a time
+    void hashState(StateHash& hash) const;
+
+private:
+    // Hot physics data
+    std::vector<Scalar> x, y;
+    std::vector<Scalar> velocityX, velocityY;
+    std::vector<Scalar> prevX, prevY;  // Position at the start of the last tick, for render interpolation
+
+    // Cold AI and bookkeeping data
+    std::vector<Handle> id;
+    std::vector<int> health;
+    std::vector<Uint8> grounded;
+    std::vector<Uint8> facingRight;
+    std::vector<Uint8> attacking;
+    std::vector<AIState> currentState;
+    std::vector<int> attackCooldownTimer;
+    std::vector<int> attackFrame;
+
+    // Perception, recomputed every tick: offset and squared distance to
+    // the nearest target
+    std::vector<int> targetIndex;
+    std::vector<Scalar> targetDx, targetDy;
+    std::vector<ScalarSq> targetDistSq;
+
+    // Navigation: platform under each target this tick, the route tables
+    // toward them and the link each enemy is following (-1 for none)
+    std::vector<int> targetPlatform;
+    PathCache paths;
+    std::vector<int> navLink;
+
+    // Event recording; AI states at the start of think(), to log the
+    // changes once it's done
+    EventLog* eventLog = nullptr;
+    std::vector<AIState> previousState;
+    Uint32 firstEntity = 0;
+    int currentFrame = 0;
+
+    // AI level of detail
+    ScalarSq lodNearRangeSq = 0;
+    int lodFarInterval = 1;
+
+    // Platform tracking (index into the level's platforms, -1 when airborne)
+    std::vector<int> currentPlatform;
+    std::vector<int> leftBound;
+    std::vector<int> rightBound;
+
+    // Slot table: each slot's generation, the index of the enemy in it
+    // (-1 when free) and the free slots, the next to use last
+    std::vector<Uint16> slotGeneration;
+    std::vector<int> slotIndex;
+    std::vector<Uint16> freeSlots;
+
+    static int slotOf(Handle handle) { return handle & (MAX_CAPACITY - 1); }
+    void releaseSlot(Handle handle);
+
+    // Phase jobs
+    ThreadPool* threads = nullptr;
+    template <typename Body>
+    void forEachJob(Body&& body);
+
+    // Update phases, the per-enemy ones over enemies [begin, end)
+    void removeDead();
+    void applyGravity(int begin, int end);
+    void perceive(const SDL_Rect* targets, int targetCount, int begin, int end);
+    void collide(const Stage& stage, CollisionSolver& solver, int begin, int end);
+    void updateTimers(int begin, int end);
+    void logStateChanges();
+
+    // AI methods
+    void updateAI(int i, const Stage& stage, const SDL_Rect& target, int targetNode, bool evaluate);
+    void patrol(int i);
+    void chase(int i, const Stage& stage, const SDL_Rect& target, int targetNode);
+    void attack(int i);
+    void retreat(int i);
+    void followLink(int i, const NavGraph::Link& link);
+    bool canSeeTarget(int i) const;
+    bool isInAttackRange(int i) const;
+
+    // Platform collision, one solver per job since each keeps its own
+    // broadphase results
+    std::vector<CollisionSolver> solvers;
+    void updateMovementBounds(int i, const SDL_Rect& platformRect);
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Categories of game events. Builds keep only the categories whose bit is
+// set in PF_EVENT_CATEGORIES; the rest compile to nothing.
+enum class EventType : Uint8 {
+    HIT,           // subject's attack connected with other
+    DAMAGE,        // subject's health went from before to after
+    STATE_CHANGE,  // subject's AI state went from before to after
+    DEATH          // subject was defeated
+};
+
+#ifndef PF_EVENT_CATEGORIES
+#define PF_EVENT_CATEGORIES 0xF
+#endif
+
+constexpr bool isEventEnabled(EventType type) {
+    return ((PF_EVENT_CATEGORIES) >> static_cast<int>(type)) & 1;
+}
+
+// Fixed-size binary event record
+struct GameEvent {
+    Uint32 frame;
+    Uint32 subject;
+    Uint32 other;
+    Sint32 before;
+    Sint32 after;
+    EventType type;
+};
+
+// Asynchronous game event channel. Each thread that records gets its own
+// lock-free single-producer ring, so recording is a handful of stores and
+// never blocks on I/O; a background thread drains every ring and writes
+// the events as text to stdout or a file. Events recorded while a ring is
+// full are dropped and counted.
+class EventLog {
+public:
+    static constexpr Uint32 RING_CAPACITY = 4096;  // Events per thread, power of two
+
+    EventLog();
+    ~EventLog();
+
+    // Start the writer thread; an empty path writes to stdout
+    bool start(const std::string& path = "");
+
+    // Write everything still queued and stop the writer thread
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    template <EventType Type>
+    void record(Uint32 frame, Uint32 subject, Uint32 other = 0, Sint32 before = 0, Sint32 after = 0) {
+        if constexpr (isEventEnabled(Type)) {
+            push({frame, subject, other, before, after, Type});
+        }
+    }
+
+    // Events lost to full rings since start()
+    Uint32 getDroppedCount() const;
+
+private:
+    struct Ring {
+        std::thread::id owner;
+        GameEvent events[RING_CAPACITY];
+        alignas(64) std::atomic<Uint32> head{0};  // Next slot to write, producer only
+        Uint32 knownTail = 0;                      // Producer's last look at tail
+        alignas(64) std::atomic<Uint32> tail{0};  // Next slot to read, writer thread only
+        std::atomic<Uint32> dropped{0};
+    };
+
+    const Uint32 id;  // Tells this log's rings apart in the per-thread cache
+    std::atomic<bool> running{false};
+
+    mutable std::mutex ringsMutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::vector<Ring*> draining;  // Writer thread's copy of rings
+
+    // The ring this thread last recorded into, and which log it belongs to
+    static thread_local Ring* cachedRing;
+    static thread_local Uint32 cachedLogId;
+
+    std::thread writer;
+    std::ofstream file;
+    std::ostream* out = nullptr;
+
+    void push(const GameEvent& event);
+    Ring* ringForThisThread();
+    void writeLoop();
+    bool drain();
+    void write(const GameEvent& event);
+};
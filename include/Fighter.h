@@ -0,0 +1,64 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <type_traits>
+#include "Scalar.h"
+
+// Playable characters, each described by its entry in FIGHTERS
+enum class Archetype : Uint8 {
+    BRAWLER,  // All-rounder
+    RUNNER,   // Fast and floaty, with a short quick jab
+    HEAVY,    // Slow and heavy, with a long, late, hard-hitting swing
+    COUNT
+};
+
+// Frame data for one attack. The hitbox is out from frame startup for
+// active frames, the attack ends after recovery more, and the next one
+// can start cooldown frames after this one did.
+struct MoveData {
+    int startup;
+    int active;
+    int recovery;
+    int cooldown;
+    int damage;
+    SDL_Rect hitbox;  // Relative to the fighter's top-left corner when facing right, mirrored facing left
+
+    constexpr int duration() const { return startup + active + recovery; }
+};
+
+struct FighterStats {
+    const char* name;
+    Scalar gravity;
+    Scalar jumpForce;
+    Scalar moveSpeed;
+    int width;
+    int height;
+    MoveData attack;
+};
+
+inline constexpr FighterStats FIGHTERS[] = {
+    {"brawler", Scalar(0.8f), Scalar(-15.0f), Scalar(5.0f), 50, 50, {0, 5, 5, 20, 1, {50, 0, 60, 50}}},
+    {"runner",  Scalar(0.6f), Scalar(-13.0f), Scalar(7.0f), 40, 45, {1, 3, 4, 12, 1, {40, 10, 40, 25}}},
+    {"heavy",   Scalar(1.0f), Scalar(-16.0f), Scalar(3.5f), 60, 60, {6, 6, 10, 32, 2, {60, -5, 80, 50}}},
+};
+static_assert(sizeof(FIGHTERS) / sizeof(FIGHTERS[0]) == static_cast<size_t>(Archetype::COUNT),
+              "Every archetype needs an entry in FIGHTERS");
+
+template <Archetype A>
+constexpr const FighterStats& fighterStats() {
+    return FIGHTERS[static_cast<int>(A)];
+}
+
+// Call function with the archetype as a compile-time constant, an
+// std::integral_constant, so its body is built once per archetype with
+// every stat folded in
+template <typename Function>
+decltype(auto) withArchetype(Archetype archetype, Function&& function) {
+    switch (archetype) {
+        case Archetype::RUNNER: return function(std::integral_constant<Archetype, Archetype::RUNNER>());
+        case Archetype::HEAVY: return function(std::integral_constant<Archetype, Archetype::HEAVY>());
+        default: return function(std::integral_constant<Archetype, Archetype::BRAWLER>());
+    }
+}
+
+// Archetype whose FighterStats name is name; false if there is none
+bool archetypeFromName(const char* name, Archetype& archetype);
@@ -0,0 +1,52 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Linear allocator for storage that only lives until the end of a frame:
+// allocating bumps a pointer and reset() releases everything at once.
+// When a frame needs more than the block holds, the extra comes from
+// overflow blocks, and the next reset replaces them all with one block big
+// enough for that frame, so from then on frames don't touch the heap.
+// Not thread safe; each thread or world keeps its own.
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // size bytes aligned to alignment, a power of two up to alignof(max_align_t)
+    void* allocate(size_t size, size_t alignment);
+
+    // Uninitialized room for count values of T. Nothing is destroyed on
+    // reset, so T must not need destroying.
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena memory is never destroyed");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Release everything allocated since the last reset
+    void reset();
+
+    size_t getUsed() const { return used + overflowUsed; }
+    size_t getCapacity() const { return capacity; }
+    size_t getHighWater() const { return highWater; }  // Most used in one frame
+    int getGrowCount() const { return grows; }         // Times the block was replaced by a bigger one
+
+private:
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity;
+    size_t used = 0;
+
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+    size_t overflowUsed = 0;
+
+    size_t highWater = 0;
+    int grows = 0;
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+
+// Rolling timing statistics over the most recent frames
+class FrameStats {
+public:
+    explicit FrameStats(int window = 600);
+
+    // Record one sample in milliseconds
+    void add(double ms);
+    void reset();
+
+    int count() const { return static_cast<int>(samples.size()); }
+    double min() const;
+    double mean() const;
+    double p99() const;
+    double percentile(int percent) const;  // Sample at or below which percent of them fall
+    double max() const;
+
+private:
+    std::vector<double> samples;
+    int window;
+    int next = 0;  // Slot overwritten once the window is full
+};
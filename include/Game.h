@@ -1,11 +1,20 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include <atomic>
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
-#include "Player.h"
-#include "Platform.h"
-#include "Enemy.h"
+#include "EventLog.h"
+#include "FrameStats.h"
+#include "HashLog.h"
+#include "Input.h"
+#include "RenderQueue.h"
+#include "RenderSnapshot.h"
+#include "Replay.h"
+#include "TripleBuffer.h"
+#include "World.h"
 
 class Game {
 public:
@@ -14,38 +23,185 @@ public:
 
     // Initialize the game
     bool init(const std::string& title, int width, int height);
+
+    // Initialize the simulation only - no window, renderer or video subsystem
+    bool initHeadless(int width, int height);
     
-    // Main game loop
+    // Main game loop. The simulation runs on its own thread at the fixed
+    // tick rate and publishes a snapshot after every tick; the calling
+    // thread, which owns SDL, handles events and draws the latest one.
     void run();
+
+    // Step the simulation as fast as possible with scripted input and
+    // report the achieved tick rate
+    void runHeadless(int ticks, Uint32 seed);
+
+    // Record every applied input, written to path on cleanup
+    void startRecording(const std::string& path);
+
+    // Take input from a replay file instead of the keyboard or script;
+    // the game stops when the replay ends
+    bool startReplay(const std::string& path);
+
+    // Log the world's state hash after every tick, written to path on
+    // cleanup, for desync_bisect to compare against another run
+    void startHashLog(const std::string& path);
+
+    // Play the compiled level at path instead of the default stage. While
+    // the game runs, the file is watched and the match restarts on the new
+    // level whenever it changes.
+    bool loadLevel(const std::string& path);
+
+    // Fighter the player plays; takes effect when the next match starts,
+    // so set it before init
+    void setFighter(Archetype archetype) { fighter = archetype; }
+
+    // Write game events to path, or to stdout when path is empty
+    bool startEventLog(const std::string& path);
+
+    // Keep polling input right up to each tick instead of once per frame,
+    // then draw the tick as soon as it's done. Trades render smoothness
+    // for lower input latency.
+    void setLatePolling(bool enabled) { latePolling = enabled; }
     
     // Clean up
     void cleanup();
 
-    // Handle events
+    // Handle events, queueing button presses and releases for the simulation
     void handleEvents();
     
     // Update game state
     void update();
+
+    // The match being played
+    World& getWorld() { return *world; }
     
-    // Render the game
-    void render();
+    // Render a snapshot, alpha being how far we are between its tick and
+    // the one before
+    void render(const RenderSnapshot& snapshot, float alpha = 1.0f);
+
+    // Timing of recent simulation ticks and rendered frames, and the time
+    // from button presses to the first frame presented after them
+    const FrameStats& getUpdateStats() const { return updateStats; }
+    const FrameStats& getRenderStats() const { return renderStats; }
+    const FrameStats& getLatencyStats() const { return latencyStats; }
+
+    // Simulation rate and the most ticks run to catch up in one frame
+    static constexpr int TICK_RATE = 60;
+    static constexpr int MAX_SUBSTEPS = 5;
 
 private:
+    // Create the world and its stage, player and enemy
+    void createLevel(int width, int height);
+
+    // Simulation thread: run fixed ticks until the game stops
+    void simulate();
+
+    // Copy the world into the next snapshot and hand it to the renderer
+    void publishSnapshot();
+
+    // Late polling: poll input until the next tick is due, then wait for
+    // that tick's snapshot
+    void waitForTick();
+
+    // Draw the platforms into the cached static layer
+    bool buildPlatformLayer(const std::vector<Platform>& platforms);
+
+    // Reload the level file if it changed since it was last loaded
+    void checkLevelReload();
+
+    // PF_ALLOCATION_CHECK builds: abort if a tick past the warm-up allocated
+    void checkAllocations(Uint64 allocations) const;
+
     // Game window
     SDL_Window* window;
     
     // Game renderer
     SDL_Renderer* renderer;
-    
-    // Game state
-    bool isRunning;
-    
-    // Player
-    std::unique_ptr<Player> player;
-    
-    // Enemy
-    std::unique_ptr<Enemy> enemy;
-    
-    // Platforms
-    std::vector<Platform> platforms;
+
+    // Draw commands collected during render(), and temporary storage for
+    // one frame, reset at its end
+    RenderQueue renderQueue;
+    FrameArena renderArena;
+
+    // Profiler overlay, toggled with F3
+    bool showProfiler = false;
+
+    // Platforms drawn once into a texture, redrawn only when the level
+    // changes, which shows up as a new platforms list in the snapshots
+    SDL_Texture* platformLayer = nullptr;
+    const std::vector<Platform>* layerPlatforms = nullptr;
+
+    // Game state, cleared from either thread to stop
+    std::atomic<bool> isRunning;
+
+    // Running without window and renderer
+    bool headless;
+
+    // Input bits applied on the next tick
+    Uint8 input = 0;
+
+    // The player's fighter
+    Archetype fighter = Archetype::BRAWLER;
+
+    // Button events from the render thread, and what they add up to on the
+    // simulation thread
+    InputQueue inputQueue;
+    InputState inputState;
+    bool latePolling = false;
+
+    // When the simulation's next tick is due, in steady clock ticks
+    std::atomic<std::chrono::steady_clock::rep> nextTickAt{0};
+
+    // Latency tracking: the simulation keeps the earliest press not yet
+    // on screen until the render thread reports presenting its tick
+    bool pendingPress = false;
+    std::chrono::steady_clock::time_point pendingPressAt;
+    int pendingPressTick = 0;
+    std::atomic<int> presentedTick{-1};
+    std::chrono::steady_clock::time_point lastMeasuredPress;  // Render thread only
+
+    // Simulation thread and the snapshots it hands to the render thread
+    std::thread simulation;
+    TripleBuffer<RenderSnapshot> snapshots;
+
+    // The current level's platforms, shared by every snapshot until the
+    // level changes
+    std::shared_ptr<const std::vector<Platform>> platforms;
+
+    // Input recording and playback
+    std::unique_ptr<ReplayRecorder> recorder;
+    std::string recordPath;
+    std::unique_ptr<ReplayPlayer> replay;
+
+    // Per-tick state hashes
+    std::unique_ptr<HashLogRecorder> hashLog;
+    std::string hashLogPath;
+
+    // Stage from a level file, and when it was last written
+    std::unique_ptr<Stage> level;
+    std::string levelPath;
+    std::filesystem::file_time_type levelWriteTime;
+    Uint32 nextLevelCheck = 0;
+
+    // How often the level file is checked for changes
+    static constexpr int LEVEL_CHECK_MS = 500;
+
+    // Late polling: how often input is polled while waiting for a tick,
+    // and how long before the tick polling stops
+    static constexpr int LATE_POLL_MS = 1;
+
+    // Ticks after a level starts before allocating counts as a bug
+    static constexpr int ALLOCATION_WARMUP_TICKS = 120;
+
+    // Game events, written out on a background thread
+    EventLog eventLog;
+
+    // Loop timing
+    FrameStats updateStats;
+    FrameStats renderStats;
+    FrameStats latencyStats;
+
+    // Simulation state
+    std::unique_ptr<World> world;
 };
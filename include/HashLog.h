@@ -0,0 +1,68 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "Fighter.h"
+#include "MappedFile.h"
+
+// Hash logs store the chained state hash after every simulation tick and
+// the input bits the tick ran with:
+//
+//   header: "PFHL", version (u16), flags (u8), fighter (u8), frame count (u32)
+//   body:   frame count x chained hash (u64), then frame count x input bits (u8)
+//
+// Nine bytes a tick, about 2 MB for an hour at 60 Hz. Two runs that should
+// agree (two peers, two builds, a replay and its recording) can be checked
+// against each other by comparing logs, and the inputs let desync_bisect
+// re-simulate either side up to where they part. All integers are little
+// endian.
+namespace HashLogFormat {
+    constexpr char MAGIC[4] = {'P', 'F', 'H', 'L'};
+    constexpr Uint16 VERSION = 1;
+    constexpr size_t HEADER_SIZE = 12;
+
+    // Flag bits
+    constexpr Uint8 FIXED_POINT = 1 << 0;  // Recorded by a PF_FIXED_POINT build
+    constexpr Uint8 WAVES = 1 << 1;        // The world ran with waves on
+}
+
+// Collects tick hashes as the simulation runs and writes them out on save()
+class HashLogRecorder {
+public:
+    // The world options a replay needs to match the run: its fighter and
+    // whether waves were on
+    HashLogRecorder(Archetype fighter, bool waves) : fighter(fighter), waves(waves) {}
+
+    // The state hash after a tick and the input it ran with
+    void record(Uint64 stateHash, Uint8 buttons);
+    bool save(const std::string& path) const;
+    Uint32 getFrameCount() const { return static_cast<Uint32>(chain.size()); }
+
+private:
+    std::vector<Uint64> chain;
+    std::vector<Uint8> inputs;
+    Archetype fighter;
+    bool waves;
+};
+
+// Memory-maps a hash log for random access to any tick
+class HashLog {
+public:
+    bool open(const std::string& path);
+
+    // Chained hash after tick frame, covering every tick up to it
+    Uint64 getHash(Uint32 frame) const;
+    Uint8 getInput(Uint32 frame) const { return file.data()[inputOffset + frame]; }
+
+    Uint32 getFrameCount() const { return frameCount; }
+    Archetype getFighter() const { return fighter; }
+    bool isFixedPoint() const { return (flags & HashLogFormat::FIXED_POINT) != 0; }
+    bool hasWaves() const { return (flags & HashLogFormat::WAVES) != 0; }
+
+private:
+    MappedFile file;
+    Uint32 frameCount = 0;
+    size_t inputOffset = 0;
+    Uint8 flags = 0;
+    Archetype fighter = Archetype::BRAWLER;
+};
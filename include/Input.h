@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <chrono>
+
+// Buttons the simulation understands, one bit each so a whole frame of
+// input fits in a single byte
+enum InputButton : Uint8 {
+    INPUT_LEFT   = 1 << 0,
+    INPUT_RIGHT  = 1 << 1,
+    INPUT_JUMP   = 1 << 2,
+    INPUT_ATTACK = 1 << 3
+};
+
+// Button bound to a key, or 0 for keys the game doesn't use
+Uint8 buttonFromScancode(SDL_Scancode scancode);
+
+// A button going down or up, stamped when it was polled from SDL
+struct InputEvent {
+    std::chrono::steady_clock::time_point time;
+    Uint8 button;  // One InputButton bit
+    bool pressed;
+};
+
+// Lock-free single-producer, single-consumer queue carrying input events
+// from the thread that polls SDL to the simulation thread
+class InputQueue {
+public:
+    static constexpr Uint32 CAPACITY = 256;  // Power of two
+
+    // False when full, dropping the event
+    bool push(const InputEvent& event);
+
+    // Oldest queued event, or null when empty, and its removal
+    const InputEvent* front();
+    void pop();
+
+private:
+    InputEvent events[CAPACITY];
+    alignas(64) std::atomic<Uint32> head{0};  // Next slot to write, producer only
+    alignas(64) std::atomic<Uint32> tail{0};  // Next slot to read, consumer only
+};
+
+// Folds timestamped input events into the buttons for each tick. Each tick
+// takes only the events that happened before it was due, leaving later
+// ones for the tick they belong to. A press counts for the tick it lands
+// in even if the button was released again before the tick ran, so taps
+// shorter than a tick aren't lost.
+class InputState {
+public:
+    // Apply the queued events stamped up to until and return the buttons
+    // for that tick. firstPress is lowered to the earliest press applied.
+    Uint8 advance(InputQueue& queue, std::chrono::steady_clock::time_point until,
+                  std::chrono::steady_clock::time_point& firstPress);
+
+private:
+    Uint8 held = 0;
+};
+
+// Deterministic stand-in for the keyboard when running headless.
+// Holds a direction for a random number of frames and mixes in jumps
+// and attacks, so the same seed always produces the same match.
+class InputScript {
+public:
+    explicit InputScript(Uint32 seed = 1);
+    Uint8 next();
+
+private:
+    Uint32 rng;
+    Uint8 held = 0;
+    int holdFrames = 0;
+
+    Uint32 random();
+};
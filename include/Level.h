@@ -0,0 +1,105 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+#include "MappedFile.h"
+#include "NavGraph.h"
+
+struct Stage;
+
+// Compiled level files are laid out to be used straight from the mapping:
+//
+//   header:   LevelHeader
+//   sections: platforms (SDL_Rect), enemy spawns (SDL_Point), grid cell
+//             starts (columns * rows + 1 Sint32), grid cell items (Sint32),
+//             navigation links (LevelNavLink)
+//
+// Each section sits at the 4-byte aligned offset the header gives. Every
+// value is a little endian 32-bit integer apart from the magic and version,
+// so the loader only checks the header and reads everything else through
+// typed pointers. The navigation links only hold for the enemy movement
+// profile they were found with, so the header records it and loaders build
+// the graph again when their enemies move differently. tools/level_compiler
+// turns text sources into this.
+namespace LevelFormat {
+    constexpr char MAGIC[4] = {'P', 'F', 'L', 'V'};
+    constexpr Uint16 VERSION = 1;
+}
+
+// Movement profile a level's navigation links were found with, speeds in
+// 16.16 fixed point whatever the build's Scalar
+struct LevelNavProfile {
+    Sint32 gravity;
+    Sint32 jumpForce;
+    Sint32 moveSpeed;
+    Sint32 width;
+    Sint32 height;
+    Sint32 fixedPoint;  // Found by a PF_FIXED_POINT build, whose rounding differs
+
+    static LevelNavProfile from(const NavGraph::Profile& profile);
+    bool operator==(const LevelNavProfile& other) const;
+};
+
+struct LevelNavLink {
+    Sint32 from;
+    Sint32 to;
+    Sint32 type;
+    Sint32 direction;
+    Sint32 takeoffX;
+    Sint32 landingX;
+    Sint32 cost;
+};
+
+struct LevelHeader {
+    char magic[4];
+    Uint16 version;
+    Uint16 reserved;
+    Sint32 width;                 // Stage bounds
+    Sint32 height;
+    SDL_Point playerSpawn;
+    Uint32 platformCount;
+    Uint32 enemySpawnCount;
+    Sint32 gridCellSize;          // PlatformGrid built by the compiler
+    Sint32 gridOriginX;
+    Sint32 gridOriginY;
+    Sint32 gridColumns;
+    Sint32 gridRows;
+    Uint32 gridItemCount;
+    LevelNavProfile navProfile;   // NavGraph built by the compiler
+    Uint32 navLinkCount;
+    Uint32 platformsOffset;
+    Uint32 enemySpawnsOffset;
+    Uint32 gridStartsOffset;
+    Uint32 gridItemsOffset;
+    Uint32 navLinksOffset;
+};
+
+static_assert(sizeof(LevelNavLink) == 28, "LevelNavLink must match the file layout");
+static_assert(sizeof(SDL_Rect) == 16 && sizeof(SDL_Point) == 8, "Level sections assume 32-bit ints");
+static_assert(sizeof(LevelHeader) == 104, "LevelHeader must match the file layout");
+
+// Read-only view of a memory-mapped compiled level
+class Level {
+public:
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    const LevelHeader& getHeader() const { return *header; }
+    const SDL_Rect* getPlatforms() const { return section<SDL_Rect>(header->platformsOffset); }
+    const SDL_Point* getEnemySpawns() const { return section<SDL_Point>(header->enemySpawnsOffset); }
+    const Sint32* getGridStarts() const { return section<Sint32>(header->gridStartsOffset); }
+    const Sint32* getGridItems() const { return section<Sint32>(header->gridItemsOffset); }
+    const LevelNavLink* getNavLinks() const { return section<LevelNavLink>(header->navLinksOffset); }
+
+    // Write a stage, its grid and navigation graph already built, as a
+    // compiled level. The file is written beside path and renamed over it,
+    // so a running game watching path never maps a half-written level.
+    static bool save(const std::string& path, const Stage& stage);
+
+private:
+    MappedFile file;
+    const LevelHeader* header = nullptr;
+
+    template <typename T>
+    const T* section(Uint32 offset) const { return reinterpret_cast<const T*>(file.data() + offset); }
+};
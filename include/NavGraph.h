@@ -0,0 +1,131 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "FrameArena.h"
+#include "Platform.h"
+#include "Scalar.h"
+
+// Navigation graph over the top surfaces of a level's platforms, built
+// once at level load. Links between platforms are only added when a body
+// with the given movement profile can actually make the trip, checked by
+// stepping the same gravity and jump values the simulation uses.
+class NavGraph {
+public:
+    // Movement of the bodies that follow the graph
+    struct Profile {
+        Scalar gravity;
+        Scalar jumpForce;
+        Scalar moveSpeed;
+        int width;
+        int height;
+    };
+
+    enum class LinkType : Uint8 {
+        WALK,   // Step across to a touching platform at the same height
+        JUMP,   // Jump from takeoffX and steer onto the platform
+        DROP    // Walk off the edge past takeoffX and fall onto the platform
+    };
+
+    struct Link {
+        int from;
+        int to;
+        LinkType type;
+        int direction;   // -1 left, 1 right
+        int takeoffX;    // Body x to head for on the source platform
+        int landingX;    // Body x to steer toward once airborne
+        int cost;
+    };
+
+    void build(const std::vector<Platform>& platforms, const Profile& profile, int stageWidth);
+
+    // Take the links an earlier build() found for the same platforms and
+    // profile, such as those stored in a compiled level, instead of
+    // stepping trajectories again
+    void assign(const std::vector<Platform>& platforms, const Profile& profile, std::vector<Link> found);
+
+    const Profile& getProfile() const { return profile; }
+    int getPlatformCount() const { return static_cast<int>(surfaces.size()); }
+    int getLinkCount() const { return static_cast<int>(links.size()); }
+    const Link& getLink(int index) const { return links[index]; }
+
+    // Bumped on every build so caches can tell stale results apart
+    int getVersion() const { return version; }
+
+    // Platform a body is standing on or would fall onto, -1 if none
+    int platformBelow(const SDL_Rect& body) const;
+
+    // Fill next with the link to take from every platform to reach target
+    // on the cheapest route, -1 where there is none. The search's working
+    // set comes from scratch.
+    void searchTo(int target, std::vector<int>& next, FrameArena& scratch) const;
+
+    // Most scratch one searchTo() takes, for sizing arenas
+    size_t getSearchScratchSize() const;
+
+private:
+    static constexpr int JUMP_COST = 100;         // Extra cost per jump, in pixels of walking
+    static constexpr int SUPPORT_TOLERANCE = 2;   // How far feet may sink into a platform and still stand on it
+    static constexpr int MAX_AIR_TICKS = 600;
+
+    Profile profile = {};
+    int version = 0;
+    int maxRise = 0;
+    std::vector<int> fallDistance;
+    std::vector<SDL_Rect> surfaces;
+
+    // All links, and the ones arriving at platform p are
+    // links[incoming[incomingStart[p] .. incomingStart[p + 1])]
+    std::vector<Link> links;
+    std::vector<int> incomingStart;
+    std::vector<int> incoming;
+
+    // Per-build tables shared by build() and assign()
+    void prepare(const std::vector<Platform>& platforms, const Profile& movement);
+    void indexLinks();
+
+    void addWalkLinks(int from, int to);
+    void addJumpLinks(int from, int to, int stageWidth);
+    void addDropLinks(int from, int stageWidth);
+    void addLink(int from, int to, LinkType type, int direction, int takeoffX, int landingX);
+
+    // Ticks for a jump to first lift the feet more than rise pixels and to
+    // come back down to that height; false if the jump peaks too low
+    bool jumpTicks(int rise, int& upTicks, int& landTicks) const;
+    // Ticks to fall drop pixels from rest
+    int fallTicks(int drop) const;
+    int reach(int ticks) const;
+};
+
+// Route tables shared by everything chasing the same targets. Each entry
+// holds one full search toward a target platform, so any number of bodies
+// heading there reuse it; a new search only runs when a target moves to a
+// platform that isn't cached, evicting the least recently used entry.
+class PathCache {
+public:
+    static constexpr int CAPACITY = 8;
+
+    // Make sure a route table toward target exists. Not thread safe; call
+    // before handing the cache to readers. A search's working set comes
+    // from scratch.
+    void prepare(const NavGraph& graph, int target, FrameArena& scratch);
+
+    // Link to take from platform from toward target, -1 when there is no
+    // route or target isn't prepared
+    int nextLink(int from, int target) const;
+
+    void clear();
+    int getSearchCount() const { return searches; }
+
+private:
+    struct Entry {
+        int target = -1;
+        unsigned lastUsed = 0;
+        std::vector<int> next;
+    };
+
+    Entry entries[CAPACITY];
+    const NavGraph* graph = nullptr;
+    int graphVersion = -1;
+    unsigned clock = 0;
+    int searches = 0;
+};
@@ -1,10 +1,11 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include "RenderQueue.h"
 
 class Platform {
 public:
     Platform(int x, int y, int width, int height);
-    void render(SDL_Renderer* renderer) const;
+    void render(RenderQueue& queue) const;
     SDL_Rect getRect() const { return rect; }
 
 private:
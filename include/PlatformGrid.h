@@ -0,0 +1,46 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Platform.h"
+
+// Uniform grid over the static platform set, built once at level load.
+// Each cell lists the platforms overlapping it so entities only test the
+// platforms near their swept bounds instead of the whole level.
+class PlatformGrid {
+public:
+    static constexpr int DEFAULT_CELL_SIZE = 128;
+
+    void build(const std::vector<Platform>& platforms, int cellSize = DEFAULT_CELL_SIZE);
+
+    // Fill out with the indices of platforms that may overlap area, in
+    // ascending order and without duplicates
+    void query(const SDL_Rect& area, std::vector<int>& out) const;
+
+    // Take a grid built earlier, such as the one stored in a compiled
+    // level, instead of building it again. cellStart holds columns * rows + 1
+    // entries and cellItems cellStart[columns * rows].
+    void assign(int cellSize, int originX, int originY, int columns, int rows,
+                const int* cellStart, const int* cellItems);
+
+    int getCellSize() const { return cellSize; }
+    int getOriginX() const { return originX; }
+    int getOriginY() const { return originY; }
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    const std::vector<int>& getCellStart() const { return cellStart; }
+    const std::vector<int>& getCellItems() const { return cellItems; }
+
+private:
+    int cellSize = DEFAULT_CELL_SIZE;
+    int originX = 0;
+    int originY = 0;
+    int columns = 0;
+    int rows = 0;
+
+    // Platform indices of cell c are cellItems[cellStart[c] .. cellStart[c + 1])
+    std::vector<int> cellStart;
+    std::vector<int> cellItems;
+
+    int columnOf(int px) const;
+    int rowOf(int py) const;
+};
@@ -1,44 +1,68 @@
 #pragma once
 #include <SDL2/SDL.h>
 #include <vector>
+#include "Collision.h"
+#include "Fighter.h"
 #include "Platform.h"
+#include "Stage.h"
+#include "Input.h"
+#include "RenderSnapshot.h"
+#include "Scalar.h"
+#include "StateHash.h"
+#include "WorldState.h"
+#include "Combat.h"
 
+// The player's fighter. Its stats and frame data come from the archetype's
+// FIGHTERS entry; the per-tick paths are built once per archetype, so a
+// player carries nothing but its state.
 class Player {
 public:
-    Player(int x, int y);
-    void update(const std::vector<Platform>& platforms);
-    void render(SDL_Renderer* renderer);
-    void handleInput(const Uint8* state);
-    SDL_Rect getRect() const { return {static_cast<int>(x), static_cast<int>(y), WIDTH, HEIGHT}; }
+    Player(int x, int y, Archetype archetype = Archetype::BRAWLER);
+    void update(const Stage& stage);
+    // Copy out what the renderer draws
+    void snapshot(BodySnapshot& body) const;
+    void handleInput(Uint8 buttons);
+    SDL_Rect getRect() const { return {toInt(x), toInt(y), stats().width, stats().height}; }
     SDL_Rect getAttackRect() const;
 
+    Archetype getArchetype() const { return archetype; }
+    const FighterStats& stats() const { return FIGHTERS[static_cast<int>(archetype)]; }
+
+    // Publish the player's hurtbox and active attack for this tick
+    void publishBoxes(Combat& combat, Uint32 entity, int frame) const;
+
+    // Copy the simulation state out of / back into the player
+    void saveState(PlayerState& state) const;
+    void loadState(const PlayerState& state);
+
+    // Feed the same fields saveState copies into hash
+    void hashState(StateHash& hash) const;
+
     bool isAttacking = false;
 
 private:
+    Archetype archetype;
     // Position
-    float x, y;
+    Scalar x, y;
+    // Position at the start of the last tick, for render interpolation
+    Scalar prevX, prevY;
     // Velocity
-    float velX, velY;
-    // Physics constants
-    const float GRAVITY = 0.8f;
-    const float JUMP_FORCE = -15.0f;
-    const float MOVE_SPEED = 5.0f;
-    // Size
-    const int WIDTH = 50;
-    const int HEIGHT = 50;
+    Scalar velX, velY;
     // State
     bool isJumping;
     bool isFacingRight;
     
-    // Attack properties
-    int attackFrame;
-    const int ATTACK_DURATION = 10; // frames
-    const int ATTACK_RANGE = 60;    // pixels
-    const int ATTACK_COOLDOWN = 20; // frames between attacks
+    // Attack state
+    int attackFrame;                // Frames since the attack started
     int attackCooldownTimer = 0;    // current cooldown timer
     bool canAttack = true;          // whether player can attack
 
-    // Collision detection
-    bool checkCollision(const SDL_Rect& a, const SDL_Rect& b) const;
-    void resolveCollision(const Platform& platform);
-}; 
\ No newline at end of file
+    // Platform collision, and the platform the last move ended on as the
+    // solver's cached contact. Only a hint, so not part of the state.
+    CollisionSolver collision;
+    int restingOn = -1;
+
+    template <Archetype A> void updateAs(const Stage& stage);
+    template <Archetype A> void handleInputAs(Uint8 buttons);
+    template <Archetype A> SDL_Rect attackRectAs() const;
+};
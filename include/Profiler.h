@@ -0,0 +1,64 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+#include "RenderQueue.h"
+
+// Frame profiler. PROFILE_ZONE("name") times the rest of the enclosing
+// scope with the CPU timestamp counter (a steady clock where there is
+// none) and appends it to the calling thread's buffer. Builds without
+// PF_PROFILE compile the zones out entirely.
+class Profiler {
+public:
+    static constexpr int MAX_ZONES = 64;
+    static constexpr int HISTORY_FRAMES = 120;        // Frames kept for the overlay
+    static constexpr int BUFFER_CAPACITY = 1 << 16;   // Zones kept per thread, oldest overwritten
+
+    // Intern a zone name, which must outlive the program (a string literal),
+    // and return its id, or -1 once MAX_ZONES are in use
+    static int registerZone(const char* name);
+    static int getZoneCount();
+    static const char* getZoneName(int zone);
+
+    // Current time in clock ticks; ticksPerMicrosecond() converts
+    static Uint64 now();
+    static double ticksPerMicrosecond();
+
+    static void record(int zone, Uint64 start, Uint64 end);
+
+    // Close the current frame, moving each zone's total time this frame
+    // into the history
+    static void endFrame();
+
+    // One row per zone with a bar per recent frame, each row scaled to its
+    // own slowest frame
+    static void drawOverlay(RenderQueue& queue, int x, int y, int width);
+
+    // Every zone still in the thread buffers as Chrome trace-event JSON,
+    // for chrome://tracing or Perfetto. Call while no zones are running.
+    static bool writeChromeTrace(const std::string& path);
+};
+
+// Times its own lifetime as one zone
+class ProfileZone {
+public:
+    explicit ProfileZone(int zone) : zone(zone), start(Profiler::now()) {}
+    ~ProfileZone() { Profiler::record(zone, start, Profiler::now()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    int zone;
+    Uint64 start;
+};
+
+#define PF_PROFILE_CONCAT_INNER(a, b) a##b
+#define PF_PROFILE_CONCAT(a, b) PF_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PF_PROFILE
+#define PROFILE_ZONE(name)                                                                   \
+    static const int PF_PROFILE_CONCAT(profileZoneId, __LINE__) = Profiler::registerZone(name); \
+    ProfileZone PF_PROFILE_CONCAT(profileZone, __LINE__)(PF_PROFILE_CONCAT(profileZoneId, __LINE__))
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "FrameArena.h"
+
+// Draw order groups. Everything in a lower layer is drawn before anything
+// in a higher one; within a layer commands are grouped by color.
+enum class RenderLayer : Uint8 {
+    WORLD,      // Platforms
+    BODIES,     // Player and enemies
+    EFFECTS,    // Attack hitboxes
+    BARS_BACK,  // Health and cooldown bar backgrounds
+    BARS,           // Health and cooldown bars
+    OVERLAY_BACK,   // Debug overlay backgrounds
+    OVERLAY         // Debug overlay contents
+};
+
+// Collects filled rectangles for a frame and submits them sorted by layer
+// and color, one SDL_RenderFillRects call per run of identical state.
+class RenderQueue {
+public:
+    void fillRect(RenderLayer layer, SDL_Color color, const SDL_Rect& rect);
+
+    // Draw everything queued and empty the queue, gathering the batches
+    // in scratch
+    void flush(SDL_Renderer* renderer, FrameArena& scratch);
+
+    // Draw calls issued by the last flush
+    int getDrawCalls() const { return drawCalls; }
+
+private:
+    struct Command {
+        Uint64 key;     // Layer, then color
+        Uint32 order;   // Submission order, keeps the sort stable
+        SDL_Rect rect;
+    };
+    std::vector<Command> commands;
+    int drawCalls = 0;
+};
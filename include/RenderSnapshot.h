@@ -0,0 +1,41 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "Platform.h"
+#include "RenderQueue.h"
+
+// Everything drawn for one body, copied out at the end of a tick
+struct BodySnapshot {
+    float prevX, prevY;   // Position at the start of the tick
+    float x, y;           // and at the end
+    int width;
+    int height;
+    bool attacking;
+    SDL_Rect attackRect;  // At the end-of-tick position
+    int barWidth;         // Player: attack cooldown left, enemies: health left, in pixels
+};
+
+// Immutable picture of the simulation after a tick, handed from the
+// simulation thread to the render thread so drawing never touches the
+// live World
+struct RenderSnapshot {
+    int tick = -1;  // -1 until the first tick is published
+    std::chrono::steady_clock::time_point publishedAt;
+
+    // Earliest button press this snapshot is the first to show, for
+    // measuring input-to-present latency
+    bool hasInput = false;
+    std::chrono::steady_clock::time_point inputAt;
+
+    // The level's platforms, shared rather than copied every tick; a new
+    // pointer means the level changed
+    std::shared_ptr<const std::vector<Platform>> platforms;
+
+    BodySnapshot player;
+    std::vector<BodySnapshot> enemies;  // Live enemies only
+
+    // Queue the bodies, alpha blending between the start and end of the tick
+    void draw(RenderQueue& queue, float alpha) const;
+};
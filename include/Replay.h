@@ -0,0 +1,55 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// Replay files store one input byte per simulation tick, run-length encoded:
+//
+//   header: "PFRP", version (u16), tick rate (u16), frame count (u32)
+//   body:   repeated [input bits (u8), run length (LEB128 varint)]
+//
+// Inputs change a few times a second at most, so a ten minute match is a
+// few KB. All integers are little endian.
+namespace ReplayFormat {
+    constexpr char MAGIC[4] = {'P', 'F', 'R', 'P'};
+    constexpr Uint16 VERSION = 1;
+    constexpr size_t HEADER_SIZE = 12;
+}
+
+// Collects inputs as they are applied and writes them out on save()
+class ReplayRecorder {
+public:
+    explicit ReplayRecorder(Uint16 tickRate) : tickRate(tickRate) {}
+
+    void record(Uint8 buttons);
+    bool save(const std::string& path) const;
+    Uint32 getFrameCount() const { return frameCount; }
+
+private:
+    std::vector<Uint8> runInputs;
+    std::vector<Uint32> runLengths;
+    Uint32 frameCount = 0;
+    Uint16 tickRate;
+};
+
+// Memory-maps a replay file and decodes it one tick at a time
+class ReplayPlayer {
+public:
+    bool open(const std::string& path);
+
+    // Input for the next tick; false once the replay is over
+    bool next(Uint8& buttons);
+
+    Uint32 getFrameCount() const { return frameCount; }
+    Uint16 getTickRate() const { return tickRate; }
+
+private:
+    MappedFile file;
+    size_t offset = 0;
+    Uint32 frameCount = 0;
+    Uint32 framesPlayed = 0;
+    Uint16 tickRate = 0;
+    Uint8 runInput = 0;
+    Uint32 runRemaining = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include "World.h"
+#include "WorldState.h"
+
+// Keeps a ring of recent world snapshots and the input used for each frame
+// so a late or mispredicted input can be fixed by restoring the snapshot
+// taken before that frame and resimulating up to the present.
+class Rollback {
+public:
+    // Frames of history kept; inputs older than this can no longer be corrected
+    static constexpr int HISTORY = 16;
+
+    explicit Rollback(World& world);
+
+    // Simulate the next frame with the given (possibly predicted) input
+    void advance(Uint8 buttons);
+
+    // Replace the input used for an earlier frame. Resimulates from that
+    // frame if the input differs from what was used. Returns false if the
+    // frame is no longer in the history.
+    bool correctInput(int frame, Uint8 buttons);
+
+    // Roll back the last count frames and resimulate them with new inputs
+    bool rollback(int count, const Uint8* correctedInputs);
+
+    // Input used for a frame still in the history
+    Uint8 getInput(int f) const { return inputs[f % HISTORY]; }
+
+    // Frame that will be simulated by the next advance()
+    int getFrame() const { return frame; }
+
+    // Oldest frame whose input can still be corrected
+    int getOldestFrame() const { return frame > HISTORY ? frame - HISTORY : 0; }
+
+    // Frames resimulated by the most recent correction
+    int getLastResimulated() const { return lastResimulated; }
+
+private:
+    World& world;
+    WorldState snapshots[HISTORY];  // State before simulating frame f, at f % HISTORY
+    Uint8 inputs[HISTORY];          // Input used for frame f, at f % HISTORY
+    int frame = 0;
+    int lastResimulated = 0;
+
+    void resimulateFrom(int from);
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Numeric type used for positions, velocities and distances in the
+// simulation. Builds with PF_FIXED_POINT use 16.16 fixed point so the same
+// inputs give bit-identical results on every compiler, optimization level
+// and floating point mode; other builds use float.
+
+#ifdef PF_FIXED_POINT
+
+class Fixed {
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int32_t ONE = 1 << FRACTION_BITS;
+
+    constexpr Fixed() : raw(0) {}
+    constexpr Fixed(int value) : raw(value * ONE) {}
+    // Only meant for compile-time constants; rounds to the nearest step
+    constexpr explicit Fixed(float value)
+        : raw(static_cast<int32_t>(value * ONE + (value >= 0 ? 0.5f : -0.5f))) {}
+
+    static constexpr Fixed fromRaw(int32_t value) { Fixed f; f.raw = value; return f; }
+    constexpr int32_t getRaw() const { return raw; }
+
+    // Truncates toward zero, like static_cast<int> on a float
+    constexpr int toInt() const { return raw / ONE; }
+    constexpr float toFloat() const { return static_cast<float>(raw) / ONE; }
+
+    constexpr Fixed operator-() const { return fromRaw(-raw); }
+    constexpr Fixed operator+(Fixed o) const { return fromRaw(raw + o.raw); }
+    constexpr Fixed operator-(Fixed o) const { return fromRaw(raw - o.raw); }
+    constexpr Fixed operator*(Fixed o) const {
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) * o.raw) >> FRACTION_BITS));
+    }
+    constexpr Fixed operator/(Fixed o) const {
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) * ONE) / o.raw));
+    }
+    Fixed& operator+=(Fixed o) { raw += o.raw; return *this; }
+    Fixed& operator-=(Fixed o) { raw -= o.raw; return *this; }
+
+    constexpr bool operator==(Fixed o) const { return raw == o.raw; }
+    constexpr bool operator!=(Fixed o) const { return raw != o.raw; }
+    constexpr bool operator<(Fixed o) const { return raw < o.raw; }
+    constexpr bool operator<=(Fixed o) const { return raw <= o.raw; }
+    constexpr bool operator>(Fixed o) const { return raw > o.raw; }
+    constexpr bool operator>=(Fixed o) const { return raw >= o.raw; }
+
+private:
+    int32_t raw;
+};
+
+// Mixed int/Fixed arithmetic with the int on the left
+constexpr Fixed operator+(int a, Fixed b) { return Fixed(a) + b; }
+constexpr Fixed operator-(int a, Fixed b) { return Fixed(a) - b; }
+constexpr bool operator<(int a, Fixed b) { return Fixed(a) < b; }
+constexpr bool operator>(int a, Fixed b) { return Fixed(a) > b; }
+
+using Scalar = Fixed;
+
+inline int toInt(Scalar v) { return v.toInt(); }
+inline float toFloat(Scalar v) { return v.toFloat(); }
+inline Scalar scalarAbs(Scalar v) { return v < Scalar(0) ? -v : v; }
+
+// The exact representation, for hashing and bitwise comparison
+inline uint32_t scalarBits(Scalar v) { return static_cast<uint32_t>(v.getRaw()); }
+
+// Squared distances are kept in 64 bits (32.32) so squares of on-screen
+// distances can't overflow
+using ScalarSq = int64_t;
+
+constexpr ScalarSq squared(Scalar v) {
+    return static_cast<int64_t>(v.getRaw()) * v.getRaw();
+}
+
+inline ScalarSq squaredLength(Scalar dx, Scalar dy) {
+    return squared(dx) + squared(dy);
+}
+
+#else
+
+using Scalar = float;
+
+inline int toInt(Scalar v) { return static_cast<int>(v); }
+inline float toFloat(Scalar v) { return v; }
+inline Scalar scalarAbs(Scalar v) { return std::abs(v); }
+
+// The exact representation, for hashing and bitwise comparison
+inline uint32_t scalarBits(Scalar v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+using ScalarSq = float;
+
+constexpr ScalarSq squared(Scalar v) { return v * v; }
+
+inline ScalarSq squaredLength(Scalar dx, Scalar dy) {
+    return dx * dx + dy * dy;
+}
+
+#endif
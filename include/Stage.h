@@ -0,0 +1,52 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Level.h"
+#include "Platform.h"
+#include "PlatformGrid.h"
+#include "NavGraph.h"
+
+// Static level data shared by everything that moves: the platforms, their
+// broadphase, the enemy navigation graph, the playable bounds and where
+// the player and enemies start
+struct Stage {
+    std::vector<Platform> platforms;
+    PlatformGrid grid;
+    NavGraph nav;
+    int width = 800;
+    int height = 600;
+    SDL_Point playerSpawn = {400, 300};
+    std::vector<SDL_Point> enemySpawns;
+
+    // Contact data for bodies resting on a platform: for each platform,
+    // the other platforms reaching into the space over its top, as the x
+    // span each covers and how far down it comes. Platform p's are
+    // obstructions[obstructionStart[p] .. obstructionStart[p + 1]); a body
+    // moving over its top that stays clear of them all can only land
+    // straight back on it. Covers bodies up to CONTACT_CLEARANCE tall that
+    // stay within CONTACT_CLEARANCE of the platform's ends.
+    struct Obstruction {
+        int left, right;
+        int bottom;
+    };
+    static constexpr int CONTACT_CLEARANCE = 128;
+    std::vector<int> obstructionStart;
+    std::vector<Obstruction> obstructions;
+
+    // The built-in stage, used when no level file is given: a ground and
+    // three platforms, built and ready to play
+    static Stage builtIn(int width = 800, int height = 600);
+
+    // Rebuild derived data after the platforms or bounds change
+    void rebuild();
+
+    // Copy a compiled level in, taking its prebuilt grid and navigation
+    // links as they are. The graph is only built again if enemies now move
+    // differently from when the level was compiled. False if the grid or
+    // links refer to platforms the level doesn't have, leaving this stage
+    // half loaded; load into a fresh stage and drop it on failure.
+    bool load(const Level& level);
+
+    // Find each platform's obstructions from the grid
+    void buildContacts();
+};
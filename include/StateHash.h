@@ -0,0 +1,94 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "Scalar.h"
+
+// Streaming 64-bit hash of simulation state. Fields are fed in one at a
+// time straight from the live objects, so hashing a tick costs one multiply
+// and rotate per field, or per 8 bytes of a field array, with no copy of
+// the state. Scalars hash by their exact bits: two worlds hash equal only
+// if they're bitwise identical.
+class StateHash {
+public:
+    void add(Uint8 value) { mix(value); }
+    void add(bool value) { mix(value ? 1 : 0); }
+    void add(int value) { mix(static_cast<Uint32>(value)); }
+    void add(Uint32 value) { mix(value); }
+    void add(Scalar value) { mix(scalarBits(value)); }
+
+    // A whole field array, length first so pools of different sizes
+    // can't collide by shifting values between fields. Hashed as raw
+    // bytes through four independent lanes, so long arrays aren't one
+    // long chain of dependent multiplies.
+    template <typename T>
+    void addAll(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "addAll hashes the values' bytes");
+        mix(values.size());
+        addBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    // The hash of everything added so far
+    Uint64 get() const {
+        Uint64 h = state;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Fold one tick's state hash into the hash of every tick before it.
+    // Once two runs' chains differ they never agree again, so the first
+    // differing tick can be found by bisection.
+    static Uint64 chain(Uint64 previous, Uint64 stateHash) {
+        StateHash hash;
+        hash.mix(previous);
+        hash.mix(stateHash);
+        return hash.get();
+    }
+
+private:
+    static constexpr Uint64 PRIME_1 = 0x9E3779B185EBCA87ull;
+    static constexpr Uint64 PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+
+    Uint64 state = PRIME_1;
+
+    static Uint64 round(Uint64 lane, Uint64 value) {
+        lane ^= value * PRIME_2;
+        return ((lane << 31) | (lane >> 33)) * PRIME_1;
+    }
+
+    void mix(Uint64 value) { state = round(state, value); }
+
+    void addBytes(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        if (size >= 32) {
+            Uint64 lanes[4] = {state, state + PRIME_1, state + PRIME_2, state - PRIME_1};
+            for (; size >= 32; bytes += 32, size -= 32) {
+                for (int lane = 0; lane < 4; lane++) {
+                    Uint64 word;
+                    std::memcpy(&word, bytes + lane * 8, 8);
+                    lanes[lane] = round(lanes[lane], word);
+                }
+            }
+            for (Uint64 lane : lanes) {
+                mix(lane);
+            }
+        }
+        for (; size >= 8; bytes += 8, size -= 8) {
+            Uint64 word;
+            std::memcpy(&word, bytes, 8);
+            mix(word);
+        }
+        if (size > 0) {
+            Uint64 word = 0;
+            for (size_t i = 0; i < size; i++) {
+                word |= static_cast<Uint64>(bytes[i]) << (i * 8);
+            }
+            mix(word);
+        }
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque. Workers take
+// their newest task first and steal the oldest task from another worker
+// when they run dry, so uneven batches still keep every core busy.
+//
+// parallelFor is the lighter way in for many small jobs each tick: no
+// task objects, just a shared counter the workers and the caller take job
+// numbers from until they run out.
+class ThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return static_cast<int>(threads.size()); }
+
+    // Queue a task. Tasks submitted from a worker go to its own deque.
+    void submit(std::function<void()> task);
+
+    // Run tasks on the calling thread until everything submitted so far
+    // has finished
+    void wait();
+
+    // Run body(job) for every job in [0, jobCount) on the workers and the
+    // calling thread, returning once all have finished. Nothing is queued
+    // or allocated. One loop at a time, and not from inside a job.
+    template <typename Body>
+    void parallelFor(int jobCount, Body&& body) {
+        using Function = std::remove_reference_t<Body>;
+        runLoop(jobCount, [](void* context, int job) { (*static_cast<Function*>(context))(job); }, &body);
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::atomic<int> queued{0};    // Tasks waiting in a deque
+    std::atomic<int> unfinished{0};  // Tasks queued or running
+    std::atomic<unsigned> nextQueue{0};
+    bool stopping = false;
+
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    // The current parallelFor. Epoch, job count and next job share one
+    // word, so a claim can't mix up two loops.
+    static constexpr int LOOP_JOB_BITS = 24;
+    static constexpr uint64_t LOOP_JOB_MASK = (uint64_t(1) << LOOP_JOB_BITS) - 1;
+    std::atomic<uint64_t> loopState{0};
+    std::atomic<void (*)(void*, int)> loopInvoke{nullptr};
+    std::atomic<void*> loopContext{nullptr};
+    std::atomic<int> loopDone{0};
+
+    void runLoop(int jobCount, void (*invoke)(void*, int), void* context);
+    bool runLoopJob();
+    bool hasLoopJob() const;
+
+    void workerLoop(int index);
+    bool popTask(int index, std::function<void()>& task);
+    bool stealTask(int thief, std::function<void()>& task);
+    void runTask(std::function<void()>& task);
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <atomic>
+
+// Lock-free single-producer, single-consumer hand-off of whole values. The
+// producer fills one slot while the consumer reads another; the third holds
+// the latest published value. Publishing and acquiring are one atomic
+// exchange each, so neither side ever waits for the other, and the
+// consumer always sees the newest complete value, skipping any it missed.
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer: the slot to fill next. Its old contents are from a few
+    // publishes ago, so containers can be refilled without reallocating.
+    T& getWriteBuffer() { return slots[writeIndex]; }
+
+    // Producer: make the filled slot the latest value
+    void publish() {
+        Uint8 previous = latest.exchange(static_cast<Uint8>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Consumer: switch to the latest value if one was published since the
+    // last call; false if the read slot is still the newest
+    bool acquire() {
+        if ((latest.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        Uint8 previous = latest.exchange(static_cast<Uint8>(readIndex), std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Consumer: the value acquired last
+    const T& getReadBuffer() const { return slots[readIndex]; }
+
+private:
+    static constexpr Uint8 INDEX_MASK = 3;
+    static constexpr Uint8 FRESH = 4;  // Set while latest holds a value the consumer hasn't taken
+
+    T slots[3];
+    alignas(64) std::atomic<Uint8> latest{1};
+    alignas(64) int writeIndex = 0;  // Producer only
+    alignas(64) int readIndex = 2;   // Consumer only
+};
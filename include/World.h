@@ -0,0 +1,99 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "Combat.h"
+#include "EnemyPool.h"
+#include "EventLog.h"
+#include "FrameArena.h"
+#include "Player.h"
+#include "RenderSnapshot.h"
+#include "Stage.h"
+#include "WorldState.h"
+
+// Everything that makes up one running match, without any window, renderer
+// or globals, so any number of worlds can be stepped side by side
+class World {
+public:
+    // Combat entity ids: the player, then one per enemy id
+    static constexpr Uint32 PLAYER_ENTITY = 0;
+    static constexpr Uint32 FIRST_ENEMY_ENTITY = 1;
+
+    // Wave timing, in ticks
+    static constexpr int WAVE_DELAY = 180;
+    static constexpr int SPAWN_INTERVAL = 30;
+
+    // Default stage sized width x height
+    World(int width, int height, Archetype fighter = Archetype::BRAWLER);
+
+    // A match on the given stage, with the player playing fighter and the
+    // player and enemies at the stage's spawns. Pools bigger than
+    // WorldState::MAX_ENEMIES run fine but can't be saved whole.
+    explicit World(const Stage& level, Archetype fighter = Archetype::BRAWLER,
+                   int enemyCapacity = WorldState::MAX_ENEMIES);
+
+    // Run one tick with the given input bits
+    void step(Uint8 buttons);
+
+    // Snapshot and restore the full simulation state
+    void saveState(WorldState& state) const;
+    void loadState(const WorldState& state);
+
+    // Hash of everything saveState captures, read straight from the live
+    // state; worlds hash equal when their saved states would match
+    Uint64 hashState() const;
+
+    // Copy the moving entities into snapshot for drawing (platforms are
+    // the caller's business)
+    void snapshot(RenderSnapshot& snapshot) const;
+
+    // Waves: once every enemy is defeated, the next wave follows after
+    // WAVE_DELAY ticks, its enemies arriving one every SPAWN_INTERVAL ticks
+    // at the stage's spawn points in turn. Wave n brings n enemies per
+    // spawn point, up to the pool's capacity; the stage's own spawns are
+    // wave 1. Off by default, so a match is over once the stage is clear.
+    void setWaves(bool enabled) { wavesEnabled = enabled; }
+    bool hasWaves() const { return wavesEnabled; }
+    int getWave() const { return wave; }
+
+    // Run the enemy phases and hit detection as jobs on pool, or all on
+    // the calling thread when pool is null. Either way gives bit-identical
+    // results; the player, damage and events stay on the calling thread.
+    void setThreadPool(ThreadPool* pool);
+
+    // Record hits, damage, deaths and AI state changes, or nothing when
+    // log is null
+    void setEventLog(EventLog* log);
+
+    const Stage& getStage() const { return stage; }
+    const Player& getPlayer() const { return player; }
+    const EnemyPool& getEnemies() const { return enemies; }
+
+    // Match progress
+    int getFrame() const { return frame; }
+    int getHitsLanded() const { return hitsLanded; }
+    int getHitsTaken() const { return hitsTaken; }
+    bool isCleared() const { return enemies.aliveCount() == 0; }
+
+private:
+    Stage stage;
+    Player player;
+    EnemyPool enemies;
+    Combat combat;
+    std::vector<HitEvent> hits;  // This tick's hits, reused
+    FrameArena arena;            // Temporary storage for one tick, reset at its end
+
+    int frame = 0;
+    int hitsLanded = 0;  // Player attacks that connected
+    int hitsTaken = 0;   // Enemy attacks that connected
+    EventLog* eventLog = nullptr;
+
+    // Wave progress: the current wave, its enemies still to arrive and
+    // ticks until the next one does
+    bool wavesEnabled = false;
+    int wave = 1;
+    int waveSpawnsLeft = 0;
+    int waveTimer = 0;
+
+    int waveSize(int number) const;
+    void updateWaves();
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <type_traits>
+#include "Fighter.h"
+#include "Scalar.h"
+
+// Plain copies of everything the simulation needs to resume from a given
+// tick. No pointers, so a whole world can be saved and restored with a
+// single memcpy for rollback.
+
+struct PlayerState {
+    Archetype archetype;
+    Scalar x, y;
+    Scalar prevX, prevY;
+    Scalar velX, velY;
+    int attackFrame;
+    int attackCooldownTimer;
+    bool isJumping;
+    bool isFacingRight;
+    bool isAttacking;
+    bool canAttack;
+};
+
+struct EnemyState {
+    Scalar x, y;
+    Scalar prevX, prevY;
+    Scalar velocityX, velocityY;
+    Uint32 id;
+    int health;
+    int attackCooldownTimer;
+    int attackFrame;
+    int currentPlatform;
+    int navLink;
+    int leftBound;
+    int rightBound;
+    Uint8 currentState;
+    bool grounded;
+    bool facingRight;
+    bool attacking;
+};
+
+// One attack that already connected with one victim, so it can't land
+// again on a later frame of the same attack
+struct HitRecord {
+    Uint32 attacker;
+    Uint32 attack;
+    Uint32 victim;
+};
+
+struct WorldState {
+    static constexpr int MAX_ENEMIES = 64;
+    static constexpr int MAX_HIT_RECORDS = 128;
+
+    int frame;
+    int hitsLanded;
+    int hitsTaken;
+    PlayerState player;
+    int enemyCount;
+    EnemyState enemies[MAX_ENEMIES];
+
+    // Enemy pool slot table, so handles issued after a restore match the
+    // ones the original run issued
+    int enemySlotCount;
+    int freeEnemySlotCount;
+    Uint16 enemySlotGenerations[MAX_ENEMIES];
+    Uint16 freeEnemySlots[MAX_ENEMIES];
+
+    // Wave progress
+    int wave;
+    int waveSpawnsLeft;
+    int waveTimer;
+
+    int hitRecordCount;
+    HitRecord hitRecords[MAX_HIT_RECORDS];
+};
+
+static_assert(std::is_trivially_copyable<WorldState>::value, "WorldState must be memcpy-able");
@@ -0,0 +1,33 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+static thread_local Uint64 allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    // Like the standard one: give the installed new_handler a chance to
+    // free memory before giving up
+    while (true) {
+        if (void* block = std::malloc(size == 0 ? 1 : size)) {
+            return block;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+Uint64 allocationCount() {
+    return allocations;
+}
@@ -0,0 +1,38 @@
+#include "BatchRunner.h"
+#include "Input.h"
+#include "World.h"
+
+std::vector<MatchResult> BatchRunner::run(int count, int maxFrames, Uint32 baseSeed) {
+    std::vector<MatchResult> results(count);
+
+    // A few matches per task keeps scheduling overhead small without
+    // leaving workers idle at the end of the batch
+    const int matchesPerTask = 4;
+    for (int first = 0; first < count; first += matchesPerTask) {
+        int last = std::min(first + matchesPerTask, count);
+        pool.submit([&results, first, last, maxFrames, baseSeed] {
+            for (int i = first; i < last; i++) {
+                results[i] = playMatch(baseSeed + i, maxFrames);
+            }
+        });
+    }
+    pool.wait();
+
+    return results;
+}
+
+MatchResult BatchRunner::playMatch(Uint32 seed, int maxFrames) {
+    World world(800, 600);
+    InputScript script(seed);
+
+    while (world.getFrame() < maxFrames && !world.isCleared()) {
+        world.step(script.next());
+    }
+
+    MatchResult result;
+    result.winner = world.isCleared() ? MatchResult::Winner::PLAYER : MatchResult::Winner::ENEMIES;
+    result.frames = world.getFrame();
+    result.hitsLanded = world.getHitsLanded();
+    result.hitsTaken = world.getHitsTaken();
+    return result;
+}
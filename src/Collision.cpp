@@ -0,0 +1,240 @@
+#include "Collision.h"
+#include <algorithm>
+
+// distance / delta, for a move of delta. Only fractions within the move
+// matter, so anything past either end is clamped before dividing; tiny
+// fixed-point deltas would otherwise overflow.
+static Scalar fraction(Scalar distance, Scalar delta) {
+    if (scalarAbs(distance) > scalarAbs(delta)) {
+        return (distance > Scalar(0)) == (delta > Scalar(0)) ? Scalar(2) : Scalar(-2);
+    }
+    return distance / delta;
+}
+
+// Fractions of the move at which the span [position, position + size)
+// starts and stops overlapping [start, start + length); false if it never
+// does. A span not moving overlaps for the whole move or not at all.
+static bool axisTimes(Scalar position, int size, Scalar delta, int start, int length, Scalar& entry, Scalar& exit) {
+    if (delta == Scalar(0)) {
+        if (position < Scalar(start + length) && position + size > Scalar(start)) {
+            entry = Scalar(-2);
+            exit = Scalar(2);
+            return true;
+        }
+        return false;
+    }
+
+    if (delta > Scalar(0)) {
+        entry = fraction(Scalar(start) - (position + size), delta);
+        exit = fraction(Scalar(start + length) - position, delta);
+    } else {
+        entry = fraction(Scalar(start + length) - position, delta);
+        exit = fraction(Scalar(start) - (position + size), delta);
+    }
+    return true;
+}
+
+// Fraction of the move (dx, dy) at which body first touches rect, and
+// whether it arrives along y. False if it misses, or overlaps from the start.
+static bool timeOfImpact(const SweptBody& body, Scalar dx, Scalar dy, const SDL_Rect& rect, Scalar& time, bool& alongY) {
+    Scalar entryX, exitX, entryY, exitY;
+    if (!axisTimes(body.x, body.width, dx, rect.x, rect.w, entryX, exitX) ||
+        !axisTimes(body.y, body.height, dy, rect.y, rect.h, entryY, exitY)) {
+        return false;
+    }
+
+    Scalar entry = std::max(entryX, entryY);
+    Scalar exit = std::min(exitX, exitY);
+    if (entry >= exit || entry < Scalar(0) || entry > Scalar(1)) {
+        return false;
+    }
+
+    // The last axis to start overlapping is the one hit; corners land
+    time = entry;
+    alongY = entryY >= entryX;
+    return true;
+}
+
+bool CollisionSolver::canSlideOn(const Stage& stage, const SweptBody& body, int platform) {
+    if (platform < 0 || platform + 1 >= static_cast<int>(stage.obstructionStart.size()) ||
+        body.height > Stage::CONTACT_CLEARANCE) {
+        return false;
+    }
+
+    // Falling onto the top from exactly on it, in one step: the sweep
+    // hits it at time 0 along y. Without downward velocity it wouldn't
+    // count as a floor contact at all.
+    SDL_Rect rect = stage.platforms[platform].getRect();
+    if (body.y != Scalar(rect.y - body.height) || !(body.velY > Scalar(0)) ||
+        toInt(std::max(scalarAbs(body.velX), scalarAbs(body.velY))) >= MAX_STEP ||
+        !(body.x < Scalar(rect.x + rect.w)) || !(body.x + body.width > Scalar(rect.x))) {
+        return false;
+    }
+
+    // The horizontal slide afterwards must stay where the obstructions
+    // were looked for, and miss every one that comes down to the body
+    Scalar left = std::min(body.x, body.x + body.velX);
+    Scalar right = std::max(body.x, body.x + body.velX) + body.width;
+    if (left < Scalar(rect.x - Stage::CONTACT_CLEARANCE) || right > Scalar(rect.x + rect.w + Stage::CONTACT_CLEARANCE)) {
+        return false;
+    }
+    int headroom = rect.y - body.height - 2;
+    for (int o = stage.obstructionStart[platform]; o < stage.obstructionStart[platform + 1]; o++) {
+        const Stage::Obstruction& obstruction = stage.obstructions[o];
+        if (obstruction.bottom > headroom && right >= Scalar(obstruction.left) && left <= Scalar(obstruction.right)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MoveResult CollisionSolver::move(const Stage& stage, SweptBody& body, int restingOn) {
+    MoveResult result;
+
+    // Land back on the cached contact and slide along it, as sweep() would
+    if (canSlideOn(stage, body, restingOn)) {
+        if (body.velX != Scalar(0)) {
+            body.x += body.velX;
+        }
+        body.velY = 0;
+        result.contacts = CONTACT_FLOOR;
+        result.floor = restingOn;
+        return result;
+    }
+
+    // Room for a query returning every grid entry, so one never grows the
+    // list mid-match
+    if (candidates.capacity() < stage.grid.getCellItems().size()) {
+        candidates.reserve(stage.grid.getCellItems().size());
+    }
+
+    int distance = toInt(std::max(scalarAbs(body.velX), scalarAbs(body.velY)));
+    int steps = distance / MAX_STEP + 1;
+
+    for (int step = 0; step < steps; step++) {
+        // Contacts zero the velocity, so later steps only carry what's left
+        Scalar dx = steps == 1 ? body.velX : body.velX / Scalar(steps);
+        Scalar dy = steps == 1 ? body.velY : body.velY / Scalar(steps);
+
+        // Platforms touching this step's swept bounds. Bodies only start
+        // inside a platform after a teleport or a level change, so one
+        // pushed into a platform outside them is left for the next tick.
+        SDL_Rect bounds = {
+            toInt(std::min(body.x, body.x + dx)) - 1,
+            toInt(std::min(body.y, body.y + dy)) - 1,
+            toInt(scalarAbs(dx)) + body.width + 3,
+            toInt(scalarAbs(dy)) + body.height + 3
+        };
+        stage.grid.query(bounds, candidates);
+
+        if (step == 0) {
+            depenetrate(stage, body, result);
+        }
+        sweep(stage, body, dx, dy, result);
+    }
+
+    return result;
+}
+
+void CollisionSolver::depenetrate(const Stage& stage, SweptBody& body, MoveResult& result) const {
+    for (int p : candidates) {
+        SDL_Rect rect = stage.platforms[p].getRect();
+
+        // How far the body would have to move each way to get out
+        Scalar left = (body.x + body.width) - rect.x;
+        Scalar right = Scalar(rect.x + rect.w) - body.x;
+        Scalar up = (body.y + body.height) - rect.y;
+        Scalar down = Scalar(rect.y + rect.h) - body.y;
+        if (left <= Scalar(0) || right <= Scalar(0) || up <= Scalar(0) || down <= Scalar(0)) continue;
+
+        if (std::min(left, right) < std::min(up, down)) {
+            if (left < right) {
+                body.x = Scalar(rect.x - body.width);
+                result.contacts |= CONTACT_RIGHT;
+                if (body.velX > Scalar(0)) body.velX = 0;
+            } else {
+                body.x = Scalar(rect.x + rect.w);
+                result.contacts |= CONTACT_LEFT;
+                if (body.velX < Scalar(0)) body.velX = 0;
+            }
+        } else if (up < down) {
+            body.y = Scalar(rect.y - body.height);
+            result.contacts |= CONTACT_FLOOR;
+            if (result.floor < 0) result.floor = p;
+            if (body.velY > Scalar(0)) body.velY = 0;
+        } else {
+            body.y = Scalar(rect.y + rect.h);
+            result.contacts |= CONTACT_CEILING;
+            if (body.velY < Scalar(0)) body.velY = 0;
+        }
+    }
+}
+
+void CollisionSolver::sweep(const Stage& stage, SweptBody& body, Scalar dx, Scalar dy, MoveResult& result) const {
+    for (int contact = 0; contact < MAX_CONTACTS; contact++) {
+        if (dx == Scalar(0) && dy == Scalar(0)) return;
+
+        // What the rest of the move sweeps over, to skip most platforms
+        // without dividing
+        Scalar left = std::min(body.x, body.x + dx);
+        Scalar right = std::max(body.x, body.x + dx) + body.width;
+        Scalar top = std::min(body.y, body.y + dy);
+        Scalar bottom = std::max(body.y, body.y + dy) + body.height;
+
+        // Earliest impact, ties going to the first platform in level order
+        Scalar earliest = Scalar(2);
+        int hit = -1;
+        bool hitAlongY = false;
+        for (int p : candidates) {
+            SDL_Rect rect = stage.platforms[p].getRect();
+            if (right < Scalar(rect.x) || left > Scalar(rect.x + rect.w) ||
+                bottom < Scalar(rect.y) || top > Scalar(rect.y + rect.h)) {
+                continue;
+            }
+
+            Scalar time;
+            bool alongY;
+            if (timeOfImpact(body, dx, dy, rect, time, alongY) && time < earliest) {
+                earliest = time;
+                hit = p;
+                hitAlongY = alongY;
+            }
+        }
+
+        if (hit < 0) {
+            body.x += dx;
+            body.y += dy;
+            return;
+        }
+
+        // Move to the contact, snapping exactly onto the platform's edge,
+        // then slide along it with whatever is left of the other axis
+        SDL_Rect rect = stage.platforms[hit].getRect();
+        if (hitAlongY) {
+            body.x += dx * earliest;
+            if (dy > Scalar(0)) {
+                body.y = Scalar(rect.y - body.height);
+                result.contacts |= CONTACT_FLOOR;
+                if (result.floor < 0) result.floor = hit;
+            } else {
+                body.y = Scalar(rect.y + rect.h);
+                result.contacts |= CONTACT_CEILING;
+            }
+            body.velY = 0;
+            dx -= dx * earliest;
+            dy = 0;
+        } else {
+            body.y += dy * earliest;
+            if (dx > Scalar(0)) {
+                body.x = Scalar(rect.x - body.width);
+                result.contacts |= CONTACT_RIGHT;
+            } else {
+                body.x = Scalar(rect.x + rect.w);
+                result.contacts |= CONTACT_LEFT;
+            }
+            body.velX = 0;
+            dy -= dy * earliest;
+            dx = 0;
+        }
+    }
+}
@@ -0,0 +1,223 @@
+#include "Combat.h"
+#include <algorithm>
+#include "Profiler.h"
+
+static bool recordLess(const HitRecord& a, const HitRecord& b) {
+    if (a.attacker != b.attacker) return a.attacker < b.attacker;
+    if (a.attack != b.attack) return a.attack < b.attack;
+    return a.victim < b.victim;
+}
+
+static bool sameRecord(const HitRecord& a, const HitRecord& b) {
+    return a.attacker == b.attacker && a.attack == b.attack && a.victim == b.victim;
+}
+
+void Combat::reserve(int entities) {
+    hitboxes.reserve(entities);
+    hurtboxes.reserve(entities);
+    intervals.reserve(entities * 4);  // Boxes may straddle a band
+    if (sweeps.empty()) {
+        sweeps.resize(1);
+    }
+    sweeps[0].activeHitboxes.reserve(entities);
+    sweeps[0].activeHurtboxes.reserve(entities);
+    sweeps[0].pairs.reserve(entities * 2);
+    jobStarts.reserve(2);
+    landed.reserve(WorldState::MAX_HIT_RECORDS);
+}
+
+void Combat::beginFrame() {
+    hitboxes.clear();
+    hurtboxes.clear();
+}
+
+void Combat::addHitbox(const SDL_Rect& rect, Uint32 owner, Uint32 attack, Team team, int damage) {
+    hitboxes.push_back({rect, owner, attack, team, damage});
+}
+
+void Combat::addHurtbox(const SDL_Rect& rect, Uint32 owner, int slot, Team team) {
+    hurtboxes.push_back({rect, owner, slot, team});
+}
+
+static int bandOf(int y) {
+    // Floor division, so boxes above the stage still get their own bands
+    return y >= 0 ? y / Combat::BAND_HEIGHT : -((-y - 1) / Combat::BAND_HEIGHT) - 1;
+}
+
+void Combat::addIntervals(const SDL_Rect& r, int index, bool isHitbox) {
+    if (r.w <= 0 || r.h <= 0) return;
+    for (int band = bandOf(r.y); band <= bandOf(r.y + r.h - 1); band++) {
+        intervals.push_back({band, r.x, r.x + r.w, index, isHitbox});
+    }
+}
+
+void Combat::resolve(std::vector<HitEvent>& hits, FrameArena& scratch) {
+    PROFILE_ZONE("Combat::resolve");
+    // Every box with an area, once per band it touches, ordered by band then
+    // left edge. Ties break on kind and index so the sweep visits pairs the
+    // same way on every machine.
+    intervals.clear();
+    for (int i = 0; i < getHitboxCount(); i++) {
+        addIntervals(hitboxes[i].rect, i, true);
+    }
+    for (int i = 0; i < getHurtboxCount(); i++) {
+        addIntervals(hurtboxes[i].rect, i, false);
+    }
+    std::sort(intervals.begin(), intervals.end(), [](const Interval& a, const Interval& b) {
+        if (a.band != b.band) return a.band < b.band;
+        if (a.minX != b.minX) return a.minX < b.minX;
+        if (a.isHitbox != b.isHitbox) return a.isHitbox;
+        return a.index < b.index;
+    });
+
+    // Bands are swept independently, so with a thread pool each job takes
+    // a run of whole bands of about JOB_INTERVALS intervals
+    jobStarts.clear();
+    jobStarts.push_back(0);
+    int intervalCount = static_cast<int>(intervals.size());
+    if (threads && intervalCount > JOB_INTERVALS) {
+        for (int i = 1; i < intervalCount; i++) {
+            if (intervals[i].band != intervals[i - 1].band && i - jobStarts.back() >= JOB_INTERVALS) {
+                jobStarts.push_back(i);
+            }
+        }
+    }
+    int jobs = static_cast<int>(jobStarts.size());
+    jobStarts.push_back(intervalCount);
+    if (static_cast<int>(sweeps.size()) < jobs) {
+        sweeps.resize(jobs);
+    }
+
+    if (jobs == 1) {
+        sweep(0, intervalCount, sweeps[0]);
+    } else {
+        threads->parallelFor(jobs, [this](int job) { sweep(jobStarts[job], jobStarts[job + 1], sweeps[job]); });
+    }
+
+    // Which job found a pair doesn't matter once they're sorted
+    std::vector<std::pair<int, int>>& found = jobs == 1 ? sweeps[0].pairs : pairs;
+    if (jobs > 1) {
+        found.clear();
+        for (int job = 0; job < jobs; job++) {
+            found.insert(found.end(), sweeps[job].pairs.begin(), sweeps[job].pairs.end());
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    // Skip attacks that already landed on this victim, and an attack with
+    // several boxes over the same victim this tick only counts once
+    using Candidate = std::pair<HitRecord, int>;  // New hit and its index in found
+    Candidate* candidates = scratch.allocate<Candidate>(found.size());
+    Candidate* candidatesEnd = candidates;
+    for (int k = 0; k < static_cast<int>(found.size()); k++) {
+        const Hitbox& hitbox = hitboxes[found[k].first];
+        HitRecord record = {hitbox.owner, hitbox.attack, hurtboxes[found[k].second].owner};
+        if (!std::binary_search(landed.begin(), landed.end(), record, recordLess)) {
+            *candidatesEnd++ = {record, k};
+        }
+    }
+    std::sort(candidates, candidatesEnd, [](const Candidate& a, const Candidate& b) {
+        if (!sameRecord(a.first, b.first)) return recordLess(a.first, b.first);
+        return a.second < b.second;
+    });
+    candidatesEnd = std::unique(candidates, candidatesEnd, [](const Candidate& a, const Candidate& b) {
+        return sameRecord(a.first, b.first);
+    });
+
+    // Forget hits of attacks that ended, then remember the new ones
+    using Attack = std::pair<Uint32, Uint32>;  // (owner, attack) with a hitbox this tick
+    Attack* activeAttacks = scratch.allocate<Attack>(hitboxes.size());
+    Attack* activeAttacksEnd = activeAttacks;
+    for (const auto& hitbox : hitboxes) {
+        *activeAttacksEnd++ = {hitbox.owner, hitbox.attack};
+    }
+    std::sort(activeAttacks, activeAttacksEnd);
+    landed.erase(std::remove_if(landed.begin(), landed.end(), [activeAttacks, activeAttacksEnd](const HitRecord& record) {
+        return !std::binary_search(activeAttacks, activeAttacksEnd, std::make_pair(record.attacker, record.attack));
+    }), landed.end());
+    for (const Candidate* candidate = candidates; candidate != candidatesEnd; candidate++) {
+        landed.push_back(candidate->first);
+    }
+    std::sort(landed.begin(), landed.end(), recordLess);
+
+    // Report in publication order
+    std::sort(candidates, candidatesEnd, [](const Candidate& a, const Candidate& b) {
+        return a.second < b.second;
+    });
+    for (const Candidate* candidate = candidates; candidate != candidatesEnd; candidate++) {
+        const Hitbox& hitbox = hitboxes[found[candidate->second].first];
+        const Hurtbox& hurtbox = hurtboxes[found[candidate->second].second];
+        hits.push_back({hitbox.owner, hurtbox.owner, hurtbox.slot, hurtbox.team, hitbox.damage});
+    }
+}
+
+void Combat::sweep(int begin, int end, Sweep& sweep) const {
+    // Sweep each band left to right keeping the boxes whose x extent is
+    // still open. A new box only needs testing against the open boxes of
+    // the other kind; ones that ended before it starts are dropped on the
+    // way. Banding keeps the open lists short on levels that are tall as
+    // well as wide.
+    sweep.activeHitboxes.clear();
+    sweep.activeHurtboxes.clear();
+    sweep.pairs.clear();
+    for (int current = begin; current < end; current++) {
+        const Interval& interval = intervals[current];
+        if (current > begin && interval.band != intervals[current - 1].band) {
+            sweep.activeHitboxes.clear();
+            sweep.activeHurtboxes.clear();
+        }
+        std::vector<int>& others = interval.isHitbox ? sweep.activeHurtboxes : sweep.activeHitboxes;
+
+        for (size_t k = 0; k < others.size();) {
+            const Interval& other = intervals[others[k]];
+            if (other.maxX <= interval.minX) {
+                others[k] = others.back();
+                others.pop_back();
+                continue;
+            }
+            if (interval.isHitbox) {
+                testPair(interval.index, other.index, interval.band, sweep.pairs);
+            } else {
+                testPair(other.index, interval.index, interval.band, sweep.pairs);
+            }
+            k++;
+        }
+
+        (interval.isHitbox ? sweep.activeHitboxes : sweep.activeHurtboxes).push_back(current);
+    }
+}
+
+void Combat::testPair(int hitboxIndex, int hurtboxIndex, int band, std::vector<std::pair<int, int>>& out) const {
+    const Hitbox& hitbox = hitboxes[hitboxIndex];
+    const Hurtbox& hurtbox = hurtboxes[hurtboxIndex];
+    if (hitbox.team == hurtbox.team || hitbox.owner == hurtbox.owner) return;
+
+    // x already overlaps, the sweep guarantees it. Boxes sharing several
+    // bands meet in each, so only the band holding the top of the overlap
+    // reports them.
+    int top = std::max(hitbox.rect.y, hurtbox.rect.y);
+    if (top < hitbox.rect.y + hitbox.rect.h &&
+        top < hurtbox.rect.y + hurtbox.rect.h &&
+        bandOf(top) == band) {
+        out.push_back({hitboxIndex, hurtboxIndex});
+    }
+}
+
+int Combat::saveState(HitRecord* records, int maxCount) const {
+    int count = std::min(static_cast<int>(landed.size()), maxCount);
+    std::copy(landed.begin(), landed.begin() + count, records);
+    return count;
+}
+
+void Combat::loadState(const HitRecord* records, int count) {
+    landed.assign(records, records + count);
+}
+
+void Combat::hashState(StateHash& hash) const {
+    hash.add(static_cast<int>(landed.size()));
+    for (const HitRecord& record : landed) {
+        hash.add(record.attacker);
+        hash.add(record.attack);
+        hash.add(record.victim);
+    }
+}
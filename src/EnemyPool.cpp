@@ -0,0 +1,702 @@
+#include "EnemyPool.h"
+#include <algorithm>
+#include "Profiler.h"
+
+EnemyPool::EnemyPool(int capacity) {
+    capacity = std::min(std::max(capacity, 0), MAX_CAPACITY);
+    x.reserve(capacity);
+    y.reserve(capacity);
+    velocityX.reserve(capacity);
+    velocityY.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    id.reserve(capacity);
+    health.reserve(capacity);
+    grounded.reserve(capacity);
+    facingRight.reserve(capacity);
+    attacking.reserve(capacity);
+    currentState.reserve(capacity);
+    attackCooldownTimer.reserve(capacity);
+    attackFrame.reserve(capacity);
+    currentPlatform.reserve(capacity);
+    navLink.reserve(capacity);
+    leftBound.reserve(capacity);
+    rightBound.reserve(capacity);
+    targetIndex.reserve(capacity);
+    targetDx.reserve(capacity);
+    targetDy.reserve(capacity);
+    targetDistSq.reserve(capacity);
+    previousState.reserve(capacity);
+    solvers.resize(std::max(1, (capacity + JOB_SIZE - 1) / JOB_SIZE));
+
+    // Every slot free, slot 0 first
+    slotGeneration.assign(capacity, 1);
+    slotIndex.assign(capacity, -1);
+    freeSlots.reserve(capacity);
+    for (int slot = capacity - 1; slot >= 0; slot--) {
+        freeSlots.push_back(static_cast<Uint16>(slot));
+    }
+}
+
+int EnemyPool::spawn(int spawnX, int spawnY) {
+    if (freeSlots.empty()) {
+        return -1;
+    }
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    slotIndex[slot] = size();
+
+    x.push_back(spawnX);
+    y.push_back(spawnY);
+    velocityX.push_back(MOVE_SPEED);
+    velocityY.push_back(0.0f);
+    prevX.push_back(spawnX);
+    prevY.push_back(spawnY);
+    id.push_back((static_cast<Handle>(slotGeneration[slot]) << SLOT_BITS) | slot);
+    health.push_back(MAX_HEALTH);
+    grounded.push_back(false);
+    facingRight.push_back(true);
+    attacking.push_back(false);
+    currentState.push_back(AIState::PATROL);
+    attackCooldownTimer.push_back(0);
+    attackFrame.push_back(0);
+    currentPlatform.push_back(-1);
+    navLink.push_back(-1);
+    leftBound.push_back(0);
+    rightBound.push_back(0);
+    return size() - 1;
+}
+
+void EnemyPool::clear() {
+    for (Handle handle : id) {
+        releaseSlot(handle);
+    }
+    x.clear();
+    y.clear();
+    velocityX.clear();
+    velocityY.clear();
+    prevX.clear();
+    prevY.clear();
+    id.clear();
+    health.clear();
+    grounded.clear();
+    facingRight.clear();
+    attacking.clear();
+    currentState.clear();
+    attackCooldownTimer.clear();
+    attackFrame.clear();
+    currentPlatform.clear();
+    navLink.clear();
+    leftBound.clear();
+    rightBound.clear();
+}
+
+template <typename Body>
+void EnemyPool::forEachJob(Body&& body) {
+    const int count = size();
+    if (!threads || count <= JOB_SIZE) {
+        body(0, 0, count);
+        return;
+    }
+    threads->parallelFor((count + JOB_SIZE - 1) / JOB_SIZE, [&body, count](int job) {
+        body(job, job * JOB_SIZE, std::min(count, (job + 1) * JOB_SIZE));
+    });
+}
+
+void EnemyPool::update(const Stage& stage, const SDL_Rect* targets, int targetCount, int frame, FrameArena& scratch) {
+    PROFILE_ZONE("EnemyPool::update");
+    beginTick(frame);
+    think(stage, targets, targetCount, scratch);
+    collide(stage);
+    updateTimers();
+}
+
+void EnemyPool::beginTick(int frame) {
+    currentFrame = frame;
+    removeDead();
+
+    // Apply gravity; collide() does the moving
+    forEachJob([this](int, int begin, int end) { applyGravity(begin, end); });
+}
+
+void EnemyPool::think(const Stage& stage, const SDL_Rect* targets, int targetCount, FrameArena& scratch) {
+    // Update AI state and behavior
+    if (targetCount > 0) {
+        targetIndex.resize(size());
+        targetDx.resize(size());
+        targetDy.resize(size());
+        targetDistSq.resize(size());
+
+        // One route table per target platform, shared by every enemy; only
+        // a target moving onto an uncached platform triggers a search
+        targetPlatform.resize(targetCount);
+        for (int t = 0; t < targetCount; t++) {
+            targetPlatform[t] = stage.nav.platformBelow(targets[t]);
+            paths.prepare(stage.nav, targetPlatform[t], scratch);
+        }
+
+        if (eventLog) {
+            previousState.assign(currentState.begin(), currentState.end());
+        }
+
+        forEachJob([&](int, int begin, int end) {
+            perceive(targets, targetCount, begin, end);
+            for (int i = begin; i < end; i++) {
+                // Far away or off-screen enemies only rethink every few frames
+                bool evaluate = true;
+                if (lodFarInterval > 1) {
+                    bool far = targetDistSq[i] > lodNearRangeSq ||
+                               x[i] + WIDTH < 0 || x[i] > stage.width ||
+                               y[i] + HEIGHT < 0 || y[i] > stage.height;
+                    evaluate = !far || (currentFrame + i) % lodFarInterval == 0;
+                }
+                int t = targetIndex[i];
+                updateAI(i, stage, targets[t], targetPlatform[t], evaluate);
+            }
+        });
+
+        if (eventLog) {
+            logStateChanges();
+        }
+    }
+}
+
+void EnemyPool::collide(const Stage& stage) {
+    forEachJob([&](int job, int begin, int end) { collide(stage, solvers[job], begin, end); });
+}
+
+void EnemyPool::updateTimers() {
+    forEachJob([this](int, int begin, int end) { updateTimers(begin, end); });
+}
+
+void EnemyPool::logStateChanges() {
+    for (int i = 0; i < size(); i++) {
+        if (currentState[i] != previousState[i]) {
+            eventLog->record<EventType::STATE_CHANGE>(currentFrame, firstEntity + id[i], 0,
+                                                      static_cast<int>(previousState[i]), static_cast<int>(currentState[i]));
+        }
+    }
+}
+
+int EnemyPool::find(Handle handle) const {
+    int slot = slotOf(handle);
+    if (slot >= getCapacity() || slotGeneration[slot] != handle >> SLOT_BITS) {
+        return -1;
+    }
+    return slotIndex[slot];
+}
+
+void EnemyPool::releaseSlot(Handle handle) {
+    int slot = slotOf(handle);
+    slotIndex[slot] = -1;
+    slotGeneration[slot] = slotGeneration[slot] == MAX_GENERATION ? 1 : slotGeneration[slot] + 1;
+    freeSlots.push_back(static_cast<Uint16>(slot));
+}
+
+int EnemyPool::aliveCount() const {
+    int alive = 0;
+    for (int h : health) {
+        if (h > 0) alive++;
+    }
+    return alive;
+}
+
+void EnemyPool::removeDead() {
+    // Swap defeated enemies with the last one so live data stays packed
+    int i = 0;
+    while (i < size()) {
+        if (health[i] > 0) {
+            i++;
+            continue;
+        }
+
+        int last = size() - 1;
+        releaseSlot(id[i]);
+        if (last != i) {
+            slotIndex[slotOf(id[last])] = i;
+        }
+        x[i] = x[last];
+        y[i] = y[last];
+        velocityX[i] = velocityX[last];
+        velocityY[i] = velocityY[last];
+        prevX[i] = prevX[last];
+        prevY[i] = prevY[last];
+        id[i] = id[last];
+        health[i] = health[last];
+        grounded[i] = grounded[last];
+        facingRight[i] = facingRight[last];
+        attacking[i] = attacking[last];
+        currentState[i] = currentState[last];
+        attackCooldownTimer[i] = attackCooldownTimer[last];
+        attackFrame[i] = attackFrame[last];
+        currentPlatform[i] = currentPlatform[last];
+        navLink[i] = navLink[last];
+        leftBound[i] = leftBound[last];
+        rightBound[i] = rightBound[last];
+
+        x.pop_back();
+        y.pop_back();
+        velocityX.pop_back();
+        velocityY.pop_back();
+        prevX.pop_back();
+        prevY.pop_back();
+        id.pop_back();
+        health.pop_back();
+        grounded.pop_back();
+        facingRight.pop_back();
+        attacking.pop_back();
+        currentState.pop_back();
+        attackCooldownTimer.pop_back();
+        attackFrame.pop_back();
+        currentPlatform.pop_back();
+        navLink.pop_back();
+        leftBound.pop_back();
+        rightBound.pop_back();
+    }
+}
+
+void EnemyPool::applyGravity(int begin, int end) {
+    const Scalar* px = x.data();
+    const Scalar* py = y.data();
+    Scalar* lastX = prevX.data();
+    Scalar* lastY = prevY.data();
+    Scalar* vy = velocityY.data();
+
+    for (int i = begin; i < end; i++) {
+        lastX[i] = px[i];
+        lastY[i] = py[i];
+        vy[i] += GRAVITY;
+    }
+}
+
+void EnemyPool::setEventLog(EventLog* log, Uint32 entity) {
+    eventLog = log;
+    firstEntity = entity;
+}
+
+void EnemyPool::setAILevelOfDetail(Scalar nearRange, int farInterval) {
+    lodNearRangeSq = squared(nearRange);
+    lodFarInterval = farInterval < 1 ? 1 : farInterval;
+}
+
+void EnemyPool::perceive(const SDL_Rect* targets, int targetCount, int begin, int end) {
+    const Scalar* px = x.data();
+    const Scalar* py = y.data();
+    int* index = targetIndex.data();
+    Scalar* dxOut = targetDx.data();
+    Scalar* dyOut = targetDy.data();
+    ScalarSq* distSq = targetDistSq.data();
+
+    // First target fills the cache, the rest only replace closer ones
+    for (int i = begin; i < end; i++) {
+        index[i] = 0;
+        Scalar dx = targets[0].x - px[i];
+        Scalar dy = targets[0].y - py[i];
+        dxOut[i] = dx;
+        dyOut[i] = dy;
+        distSq[i] = squaredLength(dx, dy);
+    }
+    for (int t = 1; t < targetCount; t++) {
+        for (int i = begin; i < end; i++) {
+            Scalar dx = targets[t].x - px[i];
+            Scalar dy = targets[t].y - py[i];
+            ScalarSq d = squaredLength(dx, dy);
+            bool closer = d < distSq[i];
+            index[i] = closer ? t : index[i];
+            dxOut[i] = closer ? dx : dxOut[i];
+            dyOut[i] = closer ? dy : dyOut[i];
+            distSq[i] = closer ? d : distSq[i];
+        }
+    }
+}
+
+void EnemyPool::collide(const Stage& stage, CollisionSolver& solver, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        SweptBody body = {x[i], y[i], velocityX[i], velocityY[i], WIDTH, HEIGHT};
+
+        // Asleep: standing still on its platform and inside the screen, so
+        // moving would only cancel this tick's gravity. Whatever gives it
+        // velocity again - the AI starting to walk or jump - wakes it.
+        if (body.velX == Scalar(0) && grounded[i] && x[i] >= 0 && x[i] + WIDTH <= stage.width &&
+            CollisionSolver::canSlideOn(stage, body, currentPlatform[i])) {
+            velocityY[i] = 0;
+            continue;
+        }
+
+        // Otherwise the platform it stood on is the contact to try first
+        MoveResult moved = solver.move(stage, body, currentPlatform[i]);
+        x[i] = body.x;
+        y[i] = body.y;
+        velocityY[i] = body.velY;
+
+        // Turn around on hitting a platform's side
+        bool hitSide = (moved.contacts & (CONTACT_LEFT | CONTACT_RIGHT)) != 0;
+        velocityX[i] = hitSide ? -velocityX[i] : body.velX;
+        grounded[i] = moved.floor >= 0;
+
+        // Update current platform and movement bounds if we're on a new platform
+        if (moved.floor != currentPlatform[i]) {
+            currentPlatform[i] = moved.floor;
+            if (moved.floor >= 0) {
+                updateMovementBounds(i, stage.platforms[moved.floor].getRect());
+            }
+        }
+
+        // Screen boundary checks
+        if (x[i] < 0) {
+            x[i] = 0;
+            velocityX[i] = MOVE_SPEED;
+        } else if (x[i] + WIDTH > stage.width) {
+            x[i] = stage.width - WIDTH;
+            velocityX[i] = -MOVE_SPEED;
+        }
+    }
+}
+
+void EnemyPool::updateTimers(int begin, int end) {
+    // Update attack cooldown
+    for (int i = begin; i < end; i++) {
+        if (attackCooldownTimer[i] > 0) {
+            attackCooldownTimer[i]--;
+        }
+    }
+
+    // Update attack animation
+    for (int i = begin; i < end; i++) {
+        if (attacking[i]) {
+            attackFrame[i]++;
+            if (attackFrame[i] >= ATTACK_DURATION) {
+                attacking[i] = false;
+                attackFrame[i] = 0;
+            }
+        }
+    }
+}
+
+void EnemyPool::updateAI(int i, const Stage& stage, const SDL_Rect& target, int targetNode, bool evaluate) {
+    // Update facing direction
+    facingRight[i] = targetDx[i] > 0;
+
+    // Between evaluations keep acting on the current state
+    if (!evaluate) {
+        switch (currentState[i]) {
+            case AIState::PATROL:  patrol(i); break;
+            case AIState::CHASE:   chase(i, stage, target, targetNode); break;
+            case AIState::ATTACK:  attack(i); break;
+            case AIState::RETREAT: retreat(i); break;
+        }
+        return;
+    }
+
+    // State machine logic; think() logs the changes
+    switch (currentState[i]) {
+        case AIState::PATROL:
+            if (canSeeTarget(i)) {
+                if (health[i] <= 2) {
+                    currentState[i] = AIState::RETREAT;
+                } else if (isInAttackRange(i)) {
+                    currentState[i] = AIState::ATTACK;
+                } else {
+                    currentState[i] = AIState::CHASE;
+                }
+            } else {
+                patrol(i);
+            }
+            break;
+
+        case AIState::CHASE:
+            if (!canSeeTarget(i)) {
+                currentState[i] = AIState::PATROL;
+            } else if (isInAttackRange(i)) {
+                currentState[i] = AIState::ATTACK;
+            } else {
+                chase(i, stage, target, targetNode);
+            }
+            break;
+
+        case AIState::ATTACK:
+            if (!isInAttackRange(i)) {
+                currentState[i] = AIState::CHASE;
+            } else {
+                attack(i);
+            }
+            break;
+
+        case AIState::RETREAT:
+            if (health[i] > 2) {
+                currentState[i] = AIState::PATROL;
+            } else {
+                retreat(i);
+            }
+            break;
+    }
+}
+
+void EnemyPool::patrol(int i) {
+    // Basic patrol behavior - move back and forth on platform
+    if (currentPlatform[i] >= 0) {
+        if (x[i] <= leftBound[i]) {
+            x[i] = leftBound[i];
+            velocityX[i] = MOVE_SPEED;
+        } else if (x[i] + WIDTH >= rightBound[i]) {
+            x[i] = rightBound[i] - WIDTH;
+            velocityX[i] = -MOVE_SPEED;
+        }
+    }
+}
+
+void EnemyPool::chase(int i, const Stage& stage, const SDL_Rect& target, int targetNode) {
+    // Pick the next link whenever we're standing on a platform; in the air
+    // keep following the one we took off on
+    int from = currentPlatform[i];
+    if (from >= 0) {
+        navLink[i] = from != targetNode ? paths.nextLink(from, targetNode) : -1;
+    }
+    if (navLink[i] >= 0) {
+        followLink(i, stage.nav.getLink(navLink[i]));
+        return;
+    }
+
+    // Same platform or no route: move towards target
+    velocityX[i] = (targetDx[i] > 0) ? MOVE_SPEED : -MOVE_SPEED;
+
+    // Jump if target is above and we're on the ground
+    if (grounded[i] && target.y < y[i] - 50) {
+        velocityY[i] = JUMP_FORCE;
+    }
+}
+
+void EnemyPool::followLink(int i, const NavGraph::Link& link) {
+    // Airborne: steer over the landing spot
+    if (currentPlatform[i] < 0) {
+        Scalar dx = link.landingX - x[i];
+        if (dx > MOVE_SPEED) {
+            velocityX[i] = MOVE_SPEED;
+        } else if (dx < -MOVE_SPEED) {
+            velocityX[i] = -MOVE_SPEED;
+        } else {
+            velocityX[i] = 0;
+        }
+        return;
+    }
+
+    // Jump once we reach the takeoff spot, otherwise head for it. Drops
+    // and walks just keep going past it.
+    Scalar dx = link.takeoffX - x[i];
+    if (link.type == NavGraph::LinkType::JUMP && grounded[i] && scalarAbs(dx) <= MOVE_SPEED) {
+        velocityX[i] = link.direction > 0 ? MOVE_SPEED : -MOVE_SPEED;
+        velocityY[i] = JUMP_FORCE;
+    } else if (link.type == NavGraph::LinkType::JUMP) {
+        velocityX[i] = dx > 0 ? MOVE_SPEED : -MOVE_SPEED;
+    } else {
+        velocityX[i] = dx >= 0 ? MOVE_SPEED : -MOVE_SPEED;
+    }
+}
+
+void EnemyPool::attack(int i) {
+    // Stop moving when attacking
+    velocityX[i] = 0;
+
+    // Perform attack if cooldown is ready
+    if (attackCooldownTimer[i] <= 0 && !attacking[i]) {
+        attacking[i] = true;
+        attackFrame[i] = 0;
+        attackCooldownTimer[i] = ATTACK_COOLDOWN;
+    }
+}
+
+void EnemyPool::retreat(int i) {
+    // Move away from target
+    Scalar dx = targetDx[i];
+    velocityX[i] = (dx > 0) ? -MOVE_SPEED : MOVE_SPEED;
+
+    // Jump to escape if target is close
+    if (grounded[i] && scalarAbs(dx) < 100) {
+        velocityY[i] = JUMP_FORCE;
+    }
+}
+
+bool EnemyPool::canSeeTarget(int i) const {
+    return targetDistSq[i] <= squared(DETECTION_RANGE);
+}
+
+bool EnemyPool::isInAttackRange(int i) const {
+    return targetDistSq[i] <= squared(ATTACK_RANGE);
+}
+
+SDL_Rect EnemyPool::getRect(int i) const {
+    return {
+        toInt(x[i]),
+        toInt(y[i]),
+        WIDTH,
+        HEIGHT
+    };
+}
+
+SDL_Rect EnemyPool::getAttackRect(int i) const {
+    if (!attacking[i] || attackFrame[i] >= ATTACK_DURATION / 2) {
+        return {0, 0, 0, 0};  // Return empty rect if not attacking or in recovery
+    }
+
+    int attackX = facingRight[i] ? toInt(x[i] + WIDTH) : toInt(x[i] - toInt(ATTACK_RANGE));
+    return {
+        attackX,
+        toInt(y[i]),
+        toInt(ATTACK_RANGE),
+        HEIGHT
+    };
+}
+
+void EnemyPool::snapshot(std::vector<BodySnapshot>& bodies) const {
+    bodies.clear();
+    for (int i = 0; i < size(); i++) {
+        if (!isAlive(i)) continue;
+
+        BodySnapshot body;
+        body.prevX = toFloat(prevX[i]);
+        body.prevY = toFloat(prevY[i]);
+        body.x = toFloat(x[i]);
+        body.y = toFloat(y[i]);
+        body.width = WIDTH;
+        body.height = HEIGHT;
+        body.attacking = attacking[i] != 0;
+        body.attackRect = getAttackRect(i);
+        body.barWidth = (WIDTH * health[i]) / MAX_HEALTH;  // Scale based on current health
+        bodies.push_back(body);
+    }
+}
+
+void EnemyPool::applyDamage(int i, int damage) {
+    health[i] = std::max(health[i] - damage, 0);
+}
+
+void EnemyPool::publishBoxes(Combat& combat, Uint32 firstEntity, int frame) const {
+    for (int i = 0; i < size(); i++) {
+        if (!isAlive(i)) continue;
+
+        Uint32 entity = firstEntity + id[i];
+        combat.addHurtbox(getRect(i), entity, i, Team::ENEMIES);
+
+        // An attack is named by the frame it started on
+        SDL_Rect attackRect = getAttackRect(i);
+        if (attackRect.w > 0) {
+            combat.addHitbox(attackRect, entity, static_cast<Uint32>(frame - attackFrame[i]), Team::ENEMIES);
+        }
+    }
+}
+
+int EnemyPool::saveState(EnemyState* states, int maxCount) const {
+    int count = std::min(size(), maxCount);
+    for (int i = 0; i < count; i++) {
+        EnemyState& state = states[i];
+        state.x = x[i];
+        state.y = y[i];
+        state.prevX = prevX[i];
+        state.prevY = prevY[i];
+        state.velocityX = velocityX[i];
+        state.velocityY = velocityY[i];
+        state.id = id[i];
+        state.health = health[i];
+        state.attackCooldownTimer = attackCooldownTimer[i];
+        state.attackFrame = attackFrame[i];
+        state.currentPlatform = currentPlatform[i];
+        state.navLink = navLink[i];
+        state.leftBound = leftBound[i];
+        state.rightBound = rightBound[i];
+        state.currentState = static_cast<Uint8>(currentState[i]);
+        state.grounded = grounded[i];
+        state.facingRight = facingRight[i];
+        state.attacking = attacking[i];
+    }
+    return count;
+}
+
+void EnemyPool::loadState(const EnemyState* states, int count) {
+    clear();
+    count = std::min(count, getCapacity());
+    for (int i = 0; i < count; i++) {
+        const EnemyState& state = states[i];
+        int slot = slotOf(state.id);
+        slotIndex[slot] = i;
+        slotGeneration[slot] = static_cast<Uint16>(state.id >> SLOT_BITS);
+        x.push_back(state.x);
+        y.push_back(state.y);
+        prevX.push_back(state.prevX);
+        prevY.push_back(state.prevY);
+        velocityX.push_back(state.velocityX);
+        velocityY.push_back(state.velocityY);
+        id.push_back(state.id);
+        health.push_back(state.health);
+        attackCooldownTimer.push_back(state.attackCooldownTimer);
+        attackFrame.push_back(state.attackFrame);
+        currentPlatform.push_back(state.currentPlatform);
+        navLink.push_back(state.navLink);
+        leftBound.push_back(state.leftBound);
+        rightBound.push_back(state.rightBound);
+        currentState.push_back(static_cast<AIState>(state.currentState));
+        grounded.push_back(state.grounded);
+        facingRight.push_back(state.facingRight);
+        attacking.push_back(state.attacking);
+    }
+
+    // Free whatever the states don't occupy; loadSlots restores the exact
+    // order if it was saved
+    freeSlots.clear();
+    for (int slot = getCapacity() - 1; slot >= 0; slot--) {
+        if (slotIndex[slot] < 0) {
+            freeSlots.push_back(static_cast<Uint16>(slot));
+        }
+    }
+}
+
+int EnemyPool::saveSlots(Uint16* generations, Uint16* freeList, int maxSlots, int& freeCount) const {
+    int slotCount = std::min(getCapacity(), maxSlots);
+    std::copy(slotGeneration.begin(), slotGeneration.begin() + slotCount, generations);
+    freeCount = 0;
+    for (Uint16 slot : freeSlots) {
+        if (slot < slotCount) {
+            freeList[freeCount++] = slot;
+        }
+    }
+    return slotCount;
+}
+
+void EnemyPool::loadSlots(const Uint16* generations, int slotCount, const Uint16* freeList, int freeCount) {
+    slotCount = std::min(slotCount, getCapacity());
+    std::copy(generations, generations + slotCount, slotGeneration.begin());
+    freeSlots.clear();
+    for (int i = 0; i < freeCount; i++) {
+        if (freeList[i] < slotCount && slotIndex[freeList[i]] < 0) {
+            freeSlots.push_back(freeList[i]);
+        }
+    }
+}
+
+void EnemyPool::hashState(StateHash& hash) const {
+    hash.addAll(x);
+    hash.addAll(y);
+    hash.addAll(prevX);
+    hash.addAll(prevY);
+    hash.addAll(velocityX);
+    hash.addAll(velocityY);
+    hash.addAll(id);
+    hash.addAll(health);
+    hash.addAll(attackCooldownTimer);
+    hash.addAll(attackFrame);
+    hash.addAll(currentPlatform);
+    hash.addAll(navLink);
+    hash.addAll(leftBound);
+    hash.addAll(rightBound);
+    hash.addAll(currentState);
+    hash.addAll(grounded);
+    hash.addAll(facingRight);
+    hash.addAll(attacking);
+    hash.addAll(slotGeneration);
+    hash.addAll(freeSlots);
+}
+
+void EnemyPool::updateMovementBounds(int i, const SDL_Rect& platformRect) {
+    // Set bounds to platform edges with a small margin
+    leftBound[i] = platformRect.x + 5;  // Small margin from left edge
+    rightBound[i] = platformRect.x + platformRect.w - 5;  // Small margin from right edge
+}
@@ -0,0 +1,160 @@
+#include "EventLog.h"
+#include <chrono>
+#include <iostream>
+
+static std::atomic<Uint32> nextLogId(1);
+
+thread_local EventLog::Ring* EventLog::cachedRing = nullptr;
+thread_local Uint32 EventLog::cachedLogId = 0;
+
+EventLog::EventLog() : id(nextLogId++) {}
+
+EventLog::~EventLog() {
+    stop();
+}
+
+bool EventLog::start(const std::string& path) {
+    stop();
+
+    if (path.empty()) {
+        out = &std::cout;
+    } else {
+        file.open(path);
+        if (!file) {
+            std::cerr << "Failed to open event log " << path << std::endl;
+            return false;
+        }
+        out = &file;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (auto& ring : rings) {
+            ring->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&EventLog::writeLoop, this);
+    return true;
+}
+
+void EventLog::stop() {
+    if (!running.exchange(false)) return;
+    writer.join();
+
+    Uint32 dropped = getDroppedCount();
+    if (dropped > 0) {
+        *out << dropped << " events dropped" << '\n';
+    }
+    out->flush();
+    if (file.is_open()) {
+        file.close();
+    }
+    out = nullptr;
+}
+
+Uint32 EventLog::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    Uint32 dropped = 0;
+    for (const auto& ring : rings) {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+void EventLog::push(const GameEvent& event) {
+    if (!isRunning()) return;
+
+    Ring* ring = ringForThisThread();
+    Uint32 head = ring->head.load(std::memory_order_relaxed);
+
+    // Only touch the writer's cache line when the ring looks full
+    if (head - ring->knownTail >= RING_CAPACITY) {
+        ring->knownTail = ring->tail.load(std::memory_order_acquire);
+        if (head - ring->knownTail >= RING_CAPACITY) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    ring->events[head & (RING_CAPACITY - 1)] = event;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+EventLog::Ring* EventLog::ringForThisThread() {
+    if (cachedLogId == id) return cachedRing;
+
+    // First event from this thread, or it last wrote to another log
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    std::thread::id self = std::this_thread::get_id();
+    Ring* found = nullptr;
+    for (auto& ring : rings) {
+        if (ring->owner == self) {
+            found = ring.get();
+            break;
+        }
+    }
+    if (!found) {
+        rings.push_back(std::make_unique<Ring>());
+        found = rings.back().get();
+        found->owner = self;
+    }
+
+    cachedRing = found;
+    cachedLogId = id;
+    return found;
+}
+
+void EventLog::writeLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (!drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Whatever was recorded before stop()
+    drain();
+}
+
+bool EventLog::drain() {
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        draining.clear();
+        for (auto& ring : rings) {
+            draining.push_back(ring.get());
+        }
+    }
+
+    bool any = false;
+    for (Ring* ring : draining) {
+        Uint32 tail = ring->tail.load(std::memory_order_relaxed);
+        Uint32 head = ring->head.load(std::memory_order_acquire);
+        for (Uint32 i = tail; i != head; i++) {
+            write(ring->events[i & (RING_CAPACITY - 1)]);
+        }
+        ring->tail.store(head, std::memory_order_release);
+        any = any || head != tail;
+    }
+    return any;
+}
+
+void EventLog::write(const GameEvent& event) {
+    std::ostream& stream = *out;
+    stream << "frame " << event.frame << ": entity " << event.subject;
+    switch (event.type) {
+        case EventType::HIT:
+            stream << " hit entity " << event.other;
+            break;
+        case EventType::DAMAGE:
+            stream << " health " << event.before << " -> " << event.after;
+            break;
+        case EventType::STATE_CHANGE:
+            stream << " state " << event.before << " -> " << event.after;
+            break;
+        case EventType::DEATH:
+            stream << " defeated";
+            break;
+    }
+    stream << '\n';
+}
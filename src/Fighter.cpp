@@ -0,0 +1,12 @@
+#include "Fighter.h"
+#include <cstring>
+
+bool archetypeFromName(const char* name, Archetype& archetype) {
+    for (int i = 0; i < static_cast<int>(Archetype::COUNT); i++) {
+        if (std::strcmp(FIGHTERS[i].name, name) == 0) {
+            archetype = static_cast<Archetype>(i);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,31 @@
+#include "FrameArena.h"
+#include <algorithm>
+
+FrameArena::FrameArena(size_t capacity) : block(new unsigned char[capacity]), capacity(capacity) {}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start + size <= capacity) {
+        used = start + size;
+        return block.get() + start;
+    }
+
+    // Doesn't fit; new[] already aligns for any fundamental type
+    overflow.emplace_back(new unsigned char[std::max<size_t>(size, 1)]);
+    overflowUsed += size + alignment;
+    return overflow.back().get();
+}
+
+void FrameArena::reset() {
+    highWater = std::max(highWater, getUsed());
+
+    if (!overflow.empty()) {
+        // Room for the whole of the frame that overflowed, plus some
+        overflow.clear();
+        capacity = std::max(capacity * 2, highWater + highWater / 2);
+        block.reset(new unsigned char[capacity]);
+        grows++;
+    }
+    used = 0;
+    overflowUsed = 0;
+}
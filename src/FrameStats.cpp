@@ -0,0 +1,52 @@
+#include "FrameStats.h"
+#include <algorithm>
+
+FrameStats::FrameStats(int window) : window(window) {
+    samples.reserve(window);
+}
+
+void FrameStats::add(double ms) {
+    if (count() < window) {
+        samples.push_back(ms);
+    } else {
+        samples[next] = ms;
+        next = (next + 1) % window;
+    }
+}
+
+void FrameStats::reset() {
+    samples.clear();
+    next = 0;
+}
+
+double FrameStats::min() const {
+    if (samples.empty()) return 0.0;
+    return *std::min_element(samples.begin(), samples.end());
+}
+
+double FrameStats::mean() const {
+    if (samples.empty()) return 0.0;
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    return sum / samples.size();
+}
+
+double FrameStats::p99() const {
+    return percentile(99);
+}
+
+double FrameStats::percentile(int percent) const {
+    if (samples.empty()) return 0.0;
+    std::vector<double> sorted(samples);
+    size_t index = (sorted.size() * percent) / 100;
+    if (index >= sorted.size()) index = sorted.size() - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+double FrameStats::max() const {
+    if (samples.empty()) return 0.0;
+    return *std::max_element(samples.begin(), samples.end());
+}
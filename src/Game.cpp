@@ -1,7 +1,15 @@
 #include "Game.h"
+#include "Input.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#ifdef PF_ALLOCATION_CHECK
+#include "AllocationCounter.h"
+#endif
 
-Game::Game() : window(nullptr), renderer(nullptr), isRunning(false) {}
+Game::Game() : window(nullptr), renderer(nullptr), isRunning(false), headless(false) {}
 
 Game::~Game() {
     cleanup();
@@ -30,23 +38,13 @@ bool Game::init(const std::string& title, int width, int height) {
     }
 
     // Create renderer
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
     if (!renderer) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
 
-    // Create platforms
-    platforms.push_back(Platform(0, 550, 800, 50));  // Ground
-    platforms.push_back(Platform(100, 400, 200, 20)); // Platform 1
-    platforms.push_back(Platform(400, 300, 200, 20)); // Platform 2
-    platforms.push_back(Platform(200, 200, 200, 20)); // Platform 3
-
-    // Create player
-    player = std::make_unique<Player>(width/2, height/2);
-
-    // Create enemy on Platform 1
-    enemy = std::make_unique<Enemy>(150, 350);
+    createLevel(width, height);
 
     // Set initial render color (black)
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
@@ -55,76 +53,369 @@ bool Game::init(const std::string& title, int width, int height) {
     return true;
 }
 
+bool Game::initHeadless(int width, int height) {
+    headless = true;
+    createLevel(width, height);
+
+    isRunning = true;
+    return true;
+}
+
+void Game::createLevel(int width, int height) {
+    world = level ? std::make_unique<World>(*level, fighter) : std::make_unique<World>(width, height, fighter);
+    world->setEventLog(eventLog.isRunning() ? &eventLog : nullptr);
+    world->setWaves(true);
+    platforms = std::make_shared<const std::vector<Platform>>(world->getStage().platforms);
+}
+
 void Game::handleEvents() {
+    PROFILE_ZONE("Game::handleEvents");
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
             isRunning = false;
+        } else if (event.type == SDL_KEYDOWN && !event.key.repeat &&
+                   event.key.keysym.scancode == SDL_SCANCODE_F3) {
+            showProfiler = !showProfiler;
+        } else if ((event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && !event.key.repeat) {
+            // Stamped now rather than with the event's millisecond
+            // timestamp, which is taken on the same poll anyway
+            Uint8 button = buttonFromScancode(event.key.keysym.scancode);
+            if (button) {
+                inputQueue.push({std::chrono::steady_clock::now(), button, event.type == SDL_KEYDOWN});
+            }
         }
     }
-    
-    // Get keyboard state
-    const Uint8* state = SDL_GetKeyboardState(NULL);
-    player->handleInput(state);
 }
 
 void Game::update() {
-    player->update(platforms);
-    if (enemy->isAlive()) {
-        enemy->update(platforms, player.get());
-        
-        // Check if player's attack hits enemy
-        if (player->isAttacking) {
-            if (enemy->isHit(player->getAttackRect())) {
-                std::cout << "Enemy hit! Remaining health: " << (enemy->isAlive() ? "Alive" : "Defeated") << std::endl;
-            }
-        }
+    PROFILE_ZONE("Game::update");
+    if (replay && !replay->next(input)) {
+        isRunning = false;
+        return;
+    }
+    if (recorder) {
+        recorder->record(input);
+    }
 
-        // Check if enemy's attack hits player
-        if (enemy->isAttacking) {
-            SDL_Rect enemyAttackRect = enemy->getAttackRect();
-            SDL_Rect playerRect = player->getRect();
-            if (SDL_HasIntersection(&enemyAttackRect, &playerRect)) {
-                std::cout << "Player hit by enemy!" << std::endl;
-            }
-        }
+#ifdef PF_ALLOCATION_CHECK
+    Uint64 allocationsBefore = allocationCount();
+    world->step(input);
+    checkAllocations(allocationCount() - allocationsBefore);
+#else
+    world->step(input);
+#endif
+
+    if (hashLog) {
+        hashLog->record(world->hashState(), input);
     }
 }
 
-void Game::render() {
+void Game::checkAllocations(Uint64 allocations) const {
+    // Only ticks after the warm-up count; the first ones size buffers
+    // and caches
+    if (allocations == 0 || world->getFrame() <= ALLOCATION_WARMUP_TICKS) return;
+
+    std::cerr << "Tick " << world->getFrame() - 1 << " made " << allocations
+              << " heap allocations in steady state" << std::endl;
+    std::abort();
+}
+
+void Game::publishSnapshot() {
+    RenderSnapshot& snapshot = snapshots.getWriteBuffer();
+    world->snapshot(snapshot);
+    snapshot.platforms = platforms;
+    snapshot.hasInput = pendingPress;
+    snapshot.inputAt = pendingPressAt;
+    snapshot.publishedAt = std::chrono::steady_clock::now();
+    snapshots.publish();
+}
+
+void Game::render(const RenderSnapshot& snapshot, float alpha) {
+    PROFILE_ZONE("Game::render");
     // Clear screen with black color
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
 
-    // Draw platforms
-    for (const auto& platform : platforms) {
-        platform.render(renderer);
+    // Draw platforms from the cached layer, or directly if the renderer
+    // can't render to textures
+    if (snapshot.platforms) {
+        if (layerPlatforms != snapshot.platforms.get() && buildPlatformLayer(*snapshot.platforms)) {
+            layerPlatforms = snapshot.platforms.get();
+        }
+        if (platformLayer && layerPlatforms == snapshot.platforms.get()) {
+            SDL_RenderCopy(renderer, platformLayer, nullptr, nullptr);
+        } else {
+            for (const auto& platform : *snapshot.platforms) {
+                platform.render(renderQueue);
+            }
+        }
     }
 
-    // Draw enemy if alive
-    if (enemy->isAlive()) {
-        enemy->render(renderer);
+    // Draw enemies and player
+    snapshot.draw(renderQueue, alpha);
+
+    if (showProfiler) {
+        Profiler::drawOverlay(renderQueue, 10, 10, 240);
     }
 
-    // Draw player
-    player->render(renderer);
+    renderQueue.flush(renderer, renderArena);
 
     // Update screen
     SDL_RenderPresent(renderer);
+
+    // Nothing allocated this frame outlives it
+    renderArena.reset();
+}
+
+bool Game::buildPlatformLayer(const std::vector<Platform>& platforms) {
+    if (!SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
+
+    if (!platformLayer) {
+        int width = 0, height = 0;
+        SDL_GetRendererOutputSize(renderer, &width, &height);
+        platformLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                          SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!platformLayer) {
+            std::cerr << "Platform layer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_SetTextureBlendMode(platformLayer, SDL_BLENDMODE_BLEND);
+    }
+
+    // Transparent background so the clear color shows through
+    SDL_SetRenderTarget(renderer, platformLayer);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    for (const auto& platform : platforms) {
+        platform.render(renderQueue);
+    }
+    renderQueue.flush(renderer, renderArena);
+    SDL_SetRenderTarget(renderer, nullptr);
+    return true;
+}
+
+void Game::simulate() {
+    using Clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / TICK_RATE));
+
+    auto nextTick = Clock::now() + tickDuration;
+    while (isRunning) {
+        nextTickAt.store(nextTick.time_since_epoch().count(), std::memory_order_relaxed);
+        std::this_thread::sleep_until(nextTick);
+        checkLevelReload();
+
+        // The renderer has shown the pending press once it presents its tick
+        if (pendingPress && presentedTick.load(std::memory_order_relaxed) >= pendingPressTick) {
+            pendingPress = false;
+        }
+
+        // Input that arrived before this tick was due, however late it runs
+        auto firstPress = Clock::time_point::max();
+        input = inputState.advance(inputQueue, nextTick, firstPress);
+
+        auto updateStart = Clock::now();
+        update();
+        updateStats.add(std::chrono::duration<double, std::milli>(Clock::now() - updateStart).count());
+
+        if (firstPress != Clock::time_point::max() && !pendingPress) {
+            pendingPress = true;
+            pendingPressAt = firstPress;
+            pendingPressTick = world->getFrame();
+        }
+        publishSnapshot();
+
+        // Ticks that fall behind run back to back to catch up; too far
+        // behind, drop the backlog rather than spiral
+        nextTick += tickDuration;
+        auto now = Clock::now();
+        if (now - nextTick >= tickDuration * MAX_SUBSTEPS) {
+            nextTick = now;
+        }
+    }
+}
+
+void Game::waitForTick() {
+    using Clock = std::chrono::steady_clock;
+    const auto poll = std::chrono::milliseconds(LATE_POLL_MS);
+
+    // Poll until just before the next tick is due, so presses made while
+    // the last frame was on screen still make it
+    auto due = Clock::time_point(Clock::duration(nextTickAt.load(std::memory_order_relaxed)));
+    while (isRunning && Clock::now() + poll < due) {
+        std::this_thread::sleep_for(poll);
+        handleEvents();
+    }
+
+    // Then wait for that tick, giving up after a tick's time in case the
+    // simulation stalls
+    auto giveUp = due + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / TICK_RATE));
+    while (isRunning && Clock::now() < giveUp) {
+        if (snapshots.acquire() && snapshots.getReadBuffer().publishedAt >= due) return;
+        std::this_thread::yield();
+    }
 }
 
 void Game::run() {
+    // The renderer has something to draw before the first tick
+    publishSnapshot();
+    simulation = std::thread(&Game::simulate, this);
+
     while (isRunning) {
         handleEvents();
+        if (latePolling) {
+            waitForTick();
+        }
+
+        // Latest complete tick, or the one drawn last frame if the
+        // simulation hasn't finished another since. Late polling draws
+        // each tick as soon as it's done, so there's nothing to blend.
+        snapshots.acquire();
+        const RenderSnapshot& snapshot = snapshots.getReadBuffer();
+        auto now = std::chrono::steady_clock::now();
+        float alpha = latePolling ? 1.0f : std::chrono::duration<float>(now - snapshot.publishedAt).count() * TICK_RATE;
+
+        render(snapshot, std::min(std::max(alpha, 0.0f), 1.0f));
+        auto presented = std::chrono::steady_clock::now();
+        renderStats.add(std::chrono::duration<double, std::milli>(presented - now).count());
+
+        if (snapshot.hasInput && snapshot.inputAt != lastMeasuredPress) {
+            latencyStats.add(std::chrono::duration<double, std::milli>(presented - snapshot.inputAt).count());
+            lastMeasuredPress = snapshot.inputAt;
+        }
+        presentedTick.store(snapshot.tick, std::memory_order_relaxed);
+        Profiler::endFrame();
+    }
+
+    simulation.join();
+
+    // Let queued events print before the summary
+    eventLog.stop();
+
+    std::cout << "Update ms  min " << updateStats.min() << "  mean " << updateStats.mean()
+              << "  p99 " << updateStats.p99() << "  max " << updateStats.max() << std::endl;
+    std::cout << "Render ms  min " << renderStats.min() << "  mean " << renderStats.mean()
+              << "  p99 " << renderStats.p99() << "  max " << renderStats.max() << std::endl;
+    if (latencyStats.count() > 0) {
+        std::cout << "Input to present ms  p50 " << latencyStats.percentile(50) << "  p90 " << latencyStats.percentile(90)
+                  << "  p99 " << latencyStats.p99() << "  max " << latencyStats.max()
+                  << "  (" << latencyStats.count() << " presses)" << std::endl;
+    }
+}
+
+void Game::runHeadless(int ticks, Uint32 seed) {
+    InputScript script(seed);
+
+    auto start = std::chrono::steady_clock::now();
+    int tick = 0;
+    while (tick < ticks && isRunning) {
+        input = script.next();
         update();
-        render();
-        
-        // Cap the frame rate
-        SDL_Delay(16); // Approximately 60 FPS
+        if (!isRunning) break;  // Replay ran out
+        tick++;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Let queued events print before the summary
+    eventLog.stop();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Simulated " << tick << " ticks in " << seconds * 1000.0 << " ms ("
+              << static_cast<long long>(seconds > 0.0 ? tick / seconds : 0.0) << " ticks/s)" << std::endl;
+}
+
+void Game::startRecording(const std::string& path) {
+    recorder = std::make_unique<ReplayRecorder>(TICK_RATE);
+    recordPath = path;
+}
+
+bool Game::startReplay(const std::string& path) {
+    replay = std::make_unique<ReplayPlayer>();
+    if (!replay->open(path)) {
+        replay.reset();
+        return false;
+    }
+    if (replay->getTickRate() != TICK_RATE) {
+        std::cerr << "Replay was recorded at " << replay->getTickRate() << " Hz, playing at " << TICK_RATE << " Hz" << std::endl;
+    }
+    return true;
+}
+
+void Game::startHashLog(const std::string& path) {
+    hashLog = std::make_unique<HashLogRecorder>(fighter, world->hasWaves());
+    hashLogPath = path;
+}
+
+bool Game::loadLevel(const std::string& path) {
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+
+    auto start = std::chrono::steady_clock::now();
+    Level file;
+    if (!file.open(path)) {
+        return false;
+    }
+    auto loaded = std::make_unique<Stage>();
+    if (!loaded->load(file)) {
+        return false;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Loaded " << path << ": " << loaded->platforms.size() << " platforms in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    level = std::move(loaded);
+    levelPath = path;
+    levelWriteTime = writeTime;
+    createLevel(level->width, level->height);
+    return true;
+}
+
+void Game::checkLevelReload() {
+    if (levelPath.empty()) return;
+
+    Uint32 now = SDL_GetTicks();
+    if (now < nextLevelCheck) return;
+    nextLevelCheck = now + LEVEL_CHECK_MS;
+
+    // A failed reload keeps the current level and retries on the next change
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(levelPath, error);
+    if (error || writeTime == levelWriteTime) return;
+    levelWriteTime = writeTime;
+    loadLevel(levelPath);
+}
+
+bool Game::startEventLog(const std::string& path) {
+    if (!eventLog.start(path)) {
+        return false;
+    }
+    if (world) {
+        world->setEventLog(&eventLog);
     }
+    return true;
 }
 
 void Game::cleanup() {
+    eventLog.stop();
+    if (recorder) {
+        if (recorder->save(recordPath)) {
+            std::cout << "Recorded " << recorder->getFrameCount() << " frames to " << recordPath << std::endl;
+        }
+        recorder.reset();
+    }
+    if (hashLog) {
+        if (hashLog->save(hashLogPath)) {
+            std::cout << "Logged " << hashLog->getFrameCount() << " frame hashes to " << hashLogPath << std::endl;
+        }
+        hashLog.reset();
+    }
+    if (platformLayer) {
+        SDL_DestroyTexture(platformLayer);
+        platformLayer = nullptr;
+    }
     if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = nullptr;
@@ -133,5 +424,7 @@ void Game::cleanup() {
         SDL_DestroyWindow(window);
         window = nullptr;
     }
-    SDL_Quit();
+    if (!headless) {
+        SDL_Quit();
+    }
 }
@@ -0,0 +1,89 @@
+#include "HashLog.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "StateHash.h"
+
+void HashLogRecorder::record(Uint64 stateHash, Uint8 buttons) {
+    chain.push_back(StateHash::chain(chain.empty() ? 0 : chain.back(), stateHash));
+    inputs.push_back(buttons);
+}
+
+bool HashLogRecorder::save(const std::string& path) const {
+    std::vector<Uint8> out;
+    out.reserve(HashLogFormat::HEADER_SIZE + chain.size() * 9);
+
+#ifdef PF_FIXED_POINT
+    Uint8 flags = HashLogFormat::FIXED_POINT;
+#else
+    Uint8 flags = 0;
+#endif
+    if (waves) flags |= HashLogFormat::WAVES;
+    Uint32 frameCount = getFrameCount();
+
+    out.insert(out.end(), HashLogFormat::MAGIC, HashLogFormat::MAGIC + 4);
+    out.push_back(HashLogFormat::VERSION & 0xFF);
+    out.push_back(HashLogFormat::VERSION >> 8);
+    out.push_back(flags);
+    out.push_back(static_cast<Uint8>(fighter));
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back((frameCount >> shift) & 0xFF);
+    }
+
+    for (Uint64 hash : chain) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            out.push_back((hash >> shift) & 0xFF);
+        }
+    }
+    out.insert(out.end(), inputs.begin(), inputs.end());
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(out.data()), out.size())) {
+        std::cerr << "Could not write hash log " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool HashLog::open(const std::string& path) {
+    if (!file.open(path)) {
+        std::cerr << "Could not open hash log " << path << std::endl;
+        return false;
+    }
+
+    const Uint8* data = file.data();
+    if (file.size() < HashLogFormat::HEADER_SIZE ||
+        std::memcmp(data, HashLogFormat::MAGIC, 4) != 0) {
+        std::cerr << path << " is not a hash log" << std::endl;
+        file.close();
+        return false;
+    }
+
+    Uint16 version = data[4] | (data[5] << 8);
+    if (version != HashLogFormat::VERSION) {
+        std::cerr << "Unsupported hash log version " << version << std::endl;
+        file.close();
+        return false;
+    }
+
+    flags = data[6];
+    frameCount = data[8] | (data[9] << 8) | (data[10] << 16) | (static_cast<Uint32>(data[11]) << 24);
+    if (data[7] >= static_cast<Uint8>(Archetype::COUNT) ||
+        file.size() < HashLogFormat::HEADER_SIZE + static_cast<size_t>(frameCount) * 9) {
+        std::cerr << path << " is truncated or corrupt" << std::endl;
+        file.close();
+        return false;
+    }
+    fighter = static_cast<Archetype>(data[7]);
+    inputOffset = HashLogFormat::HEADER_SIZE + static_cast<size_t>(frameCount) * 8;
+    return true;
+}
+
+Uint64 HashLog::getHash(Uint32 frame) const {
+    const Uint8* bytes = file.data() + HashLogFormat::HEADER_SIZE + static_cast<size_t>(frame) * 8;
+    Uint64 hash = 0;
+    for (int i = 7; i >= 0; i--) {
+        hash = (hash << 8) | bytes[i];
+    }
+    return hash;
+}
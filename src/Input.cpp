@@ -0,0 +1,79 @@
+#include "Input.h"
+
+Uint8 buttonFromScancode(SDL_Scancode scancode) {
+    switch (scancode) {
+        case SDL_SCANCODE_LEFT: return INPUT_LEFT;
+        case SDL_SCANCODE_RIGHT: return INPUT_RIGHT;
+        case SDL_SCANCODE_SPACE: return INPUT_JUMP;
+        case SDL_SCANCODE_Z: return INPUT_ATTACK;
+        default: return 0;
+    }
+}
+
+bool InputQueue::push(const InputEvent& event) {
+    Uint32 position = head.load(std::memory_order_relaxed);
+    if (position - tail.load(std::memory_order_acquire) >= CAPACITY) {
+        return false;
+    }
+    events[position & (CAPACITY - 1)] = event;
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+const InputEvent* InputQueue::front() {
+    Uint32 position = tail.load(std::memory_order_relaxed);
+    if (position == head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &events[position & (CAPACITY - 1)];
+}
+
+void InputQueue::pop() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+Uint8 InputState::advance(InputQueue& queue, std::chrono::steady_clock::time_point until,
+                          std::chrono::steady_clock::time_point& firstPress) {
+    Uint8 tapped = 0;
+    while (const InputEvent* event = queue.front()) {
+        if (event->time > until) break;
+
+        if (event->pressed) {
+            held |= event->button;
+            tapped |= event->button;
+            if (event->time < firstPress) firstPress = event->time;
+        } else {
+            held &= ~event->button;
+        }
+        queue.pop();
+    }
+    return held | tapped;
+}
+
+InputScript::InputScript(Uint32 seed) : rng(seed ? seed : 1) {}
+
+Uint32 InputScript::random() {
+    // xorshift32 - cheap and identical on every platform
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+Uint8 InputScript::next() {
+    // Pick a new direction once the current one has been held long enough
+    if (holdFrames <= 0) {
+        switch (random() % 3) {
+            case 0: held = INPUT_LEFT; break;
+            case 1: held = INPUT_RIGHT; break;
+            default: held = 0; break;
+        }
+        holdFrames = 10 + random() % 50;
+    }
+    holdFrames--;
+
+    Uint8 buttons = held;
+    if (random() % 30 == 0) buttons |= INPUT_JUMP;
+    if (random() % 15 == 0) buttons |= INPUT_ATTACK;
+    return buttons;
+}
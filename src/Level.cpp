@@ -0,0 +1,154 @@
+#include "Level.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "Stage.h"
+
+// Whether count items of itemSize fit in the file at a 4-byte aligned offset
+static bool sectionFits(Uint32 offset, Uint64 count, size_t itemSize, size_t fileSize) {
+    return offset % 4 == 0 && offset <= fileSize && count * itemSize <= fileSize - offset;
+}
+
+LevelNavProfile LevelNavProfile::from(const NavGraph::Profile& profile) {
+    auto toFixed = [](Scalar value) { return static_cast<Sint32>(std::lround(toFloat(value) * 65536.0)); };
+    LevelNavProfile out;
+    out.gravity = toFixed(profile.gravity);
+    out.jumpForce = toFixed(profile.jumpForce);
+    out.moveSpeed = toFixed(profile.moveSpeed);
+    out.width = profile.width;
+    out.height = profile.height;
+#ifdef PF_FIXED_POINT
+    out.fixedPoint = 1;
+#else
+    out.fixedPoint = 0;
+#endif
+    return out;
+}
+
+bool LevelNavProfile::operator==(const LevelNavProfile& other) const {
+    return gravity == other.gravity && jumpForce == other.jumpForce && moveSpeed == other.moveSpeed &&
+           width == other.width && height == other.height && fixedPoint == other.fixedPoint;
+}
+
+bool Level::open(const std::string& path) {
+    close();
+
+#if defined(SDL_BYTEORDER) && defined(SDL_BIG_ENDIAN) && SDL_BYTEORDER == SDL_BIG_ENDIAN
+    std::cerr << "Compiled levels are little endian and can't be mapped on this platform" << std::endl;
+    return false;
+#endif
+
+    if (!file.open(path)) {
+        std::cerr << "Could not open level " << path << std::endl;
+        return false;
+    }
+
+    const LevelHeader* candidate = reinterpret_cast<const LevelHeader*>(file.data());
+    if (file.size() < sizeof(LevelHeader) ||
+        std::memcmp(candidate->magic, LevelFormat::MAGIC, 4) != 0) {
+        std::cerr << path << " is not a compiled level" << std::endl;
+        file.close();
+        return false;
+    }
+    if (candidate->version != LevelFormat::VERSION) {
+        std::cerr << "Unsupported level version " << candidate->version << std::endl;
+        file.close();
+        return false;
+    }
+
+    // Only the layout is checked here; Stage::load checks the indices it copies
+    Uint64 cells = static_cast<Uint64>(candidate->gridColumns) * static_cast<Uint64>(candidate->gridRows);
+    bool valid = candidate->gridColumns >= 0 && candidate->gridRows >= 0 &&
+                 (cells > 0 || candidate->platformCount == 0) &&
+                 sectionFits(candidate->platformsOffset, candidate->platformCount, sizeof(SDL_Rect), file.size()) &&
+                 sectionFits(candidate->enemySpawnsOffset, candidate->enemySpawnCount, sizeof(SDL_Point), file.size()) &&
+                 sectionFits(candidate->gridStartsOffset, cells + 1, sizeof(Sint32), file.size()) &&
+                 sectionFits(candidate->gridItemsOffset, candidate->gridItemCount, sizeof(Sint32), file.size()) &&
+                 sectionFits(candidate->navLinksOffset, candidate->navLinkCount, sizeof(LevelNavLink), file.size());
+    if (!valid) {
+        std::cerr << path << " is truncated or corrupt" << std::endl;
+        file.close();
+        return false;
+    }
+
+    header = candidate;
+    return true;
+}
+
+void Level::close() {
+    file.close();
+    header = nullptr;
+}
+
+bool Level::save(const std::string& path, const Stage& stage) {
+    const PlatformGrid& grid = stage.grid;
+    const std::vector<int>& starts = grid.getCellStart();
+    const std::vector<int>& items = grid.getCellItems();
+
+    LevelHeader out = {};
+    std::memcpy(out.magic, LevelFormat::MAGIC, 4);
+    out.version = LevelFormat::VERSION;
+    out.width = stage.width;
+    out.height = stage.height;
+    out.playerSpawn = stage.playerSpawn;
+    out.platformCount = static_cast<Uint32>(stage.platforms.size());
+    out.enemySpawnCount = static_cast<Uint32>(stage.enemySpawns.size());
+    out.gridCellSize = grid.getCellSize();
+    out.gridOriginX = grid.getOriginX();
+    out.gridOriginY = grid.getOriginY();
+    out.gridColumns = grid.getColumns();
+    out.gridRows = grid.getRows();
+    out.gridItemCount = static_cast<Uint32>(items.size());
+    out.navProfile = LevelNavProfile::from(stage.nav.getProfile());
+    out.navLinkCount = static_cast<Uint32>(stage.nav.getLinkCount());
+
+    // An empty grid still has its one terminating start
+    std::vector<int> gridStarts = starts.empty() ? std::vector<int>(1, 0) : starts;
+
+    out.platformsOffset = sizeof(LevelHeader);
+    out.enemySpawnsOffset = out.platformsOffset + out.platformCount * sizeof(SDL_Rect);
+    out.gridStartsOffset = out.enemySpawnsOffset + out.enemySpawnCount * sizeof(SDL_Point);
+    out.gridItemsOffset = out.gridStartsOffset + static_cast<Uint32>(gridStarts.size() * sizeof(Sint32));
+    out.navLinksOffset = out.gridItemsOffset + out.gridItemCount * sizeof(Sint32);
+
+    std::vector<SDL_Rect> rects;
+    rects.reserve(stage.platforms.size());
+    for (const auto& platform : stage.platforms) {
+        rects.push_back(platform.getRect());
+    }
+
+    std::vector<LevelNavLink> navLinks;
+    navLinks.reserve(stage.nav.getLinkCount());
+    for (int l = 0; l < stage.nav.getLinkCount(); l++) {
+        const NavGraph::Link& link = stage.nav.getLink(l);
+        navLinks.push_back({link.from, link.to, static_cast<Sint32>(link.type), link.direction,
+                            link.takeoffX, link.landingX, link.cost});
+    }
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&out), sizeof(out));
+        file.write(reinterpret_cast<const char*>(rects.data()), rects.size() * sizeof(SDL_Rect));
+        file.write(reinterpret_cast<const char*>(stage.enemySpawns.data()), stage.enemySpawns.size() * sizeof(SDL_Point));
+        file.write(reinterpret_cast<const char*>(gridStarts.data()), gridStarts.size() * sizeof(Sint32));
+        file.write(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(Sint32));
+        file.write(reinterpret_cast<const char*>(navLinks.data()), navLinks.size() * sizeof(LevelNavLink));
+        if (!file) {
+            std::cerr << "Could not write level " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    std::remove(path.c_str());  // rename() only replaces existing files on POSIX
+#endif
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Could not replace level " << path << std::endl;
+        return false;
+    }
+    return true;
+}
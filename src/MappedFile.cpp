@@ -0,0 +1,74 @@
+#include "MappedFile.h"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PF_HAVE_MMAP 1
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef PF_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            bytes = static_cast<const unsigned char*>(view);
+            length = static_cast<size_t>(info.st_size);
+            mapped = true;
+        }
+    }
+    ::close(fd);
+    if (mapped) {
+        return true;
+    }
+#endif
+
+    // No mmap available (or it failed) - read the file into memory instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamsize fileSize = file.tellg();
+    if (fileSize <= 0) {
+        return false;
+    }
+    unsigned char* buffer = new unsigned char[fileSize];
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer), fileSize)) {
+        delete[] buffer;
+        return false;
+    }
+    bytes = buffer;
+    length = static_cast<size_t>(fileSize);
+    return true;
+}
+
+void MappedFile::close() {
+    if (!bytes) return;
+
+#ifdef PF_HAVE_MMAP
+    if (mapped) {
+        munmap(const_cast<unsigned char*>(bytes), length);
+    } else
+#endif
+    {
+        delete[] bytes;
+    }
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+}
@@ -0,0 +1,324 @@
+#include "NavGraph.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+
+// Versions are unique across all graphs so a cache never mistakes a
+// rebuilt graph at the same address for the one it searched
+static std::atomic<int> nextVersion(1);
+
+void NavGraph::build(const std::vector<Platform>& platforms, const Profile& movement, int stageWidth) {
+    prepare(platforms, movement);
+    links.clear();
+
+    const int count = getPlatformCount();
+    for (int from = 0; from < count; from++) {
+        for (int to = 0; to < count; to++) {
+            if (from == to) continue;
+            addWalkLinks(from, to);
+            addJumpLinks(from, to, stageWidth);
+        }
+        addDropLinks(from, stageWidth);
+    }
+
+    indexLinks();
+}
+
+void NavGraph::assign(const std::vector<Platform>& platforms, const Profile& movement, std::vector<Link> found) {
+    prepare(platforms, movement);
+    links = std::move(found);
+    indexLinks();
+}
+
+void NavGraph::prepare(const std::vector<Platform>& platforms, const Profile& movement) {
+    profile = movement;
+    version = nextVersion++;
+    surfaces.clear();
+
+    for (const auto& platform : platforms) {
+        surfaces.push_back(platform.getRect());
+    }
+
+    // Highest rise a jump can clear, so most platform pairs are rejected
+    // without stepping a trajectory
+    Scalar height = 0;
+    Scalar speed = -profile.jumpForce;
+    while (speed > Scalar(0)) {
+        speed -= profile.gravity;
+        height += speed;
+    }
+    maxRise = toInt(height) + 1;
+
+    // Distance fallen from rest after each tick, whole pixels rounded up
+    fallDistance.clear();
+    Scalar fallen = 0;
+    speed = 0;
+    for (int tick = 1; tick <= MAX_AIR_TICKS; tick++) {
+        speed += profile.gravity;
+        fallen += speed;
+        int whole = toInt(fallen);
+        fallDistance.push_back(Scalar(whole) < fallen ? whole + 1 : whole);
+    }
+}
+
+void NavGraph::indexLinks() {
+    // Group links by destination for the backward searches
+    const int count = getPlatformCount();
+    incomingStart.assign(count + 1, 0);
+    for (const auto& link : links) {
+        incomingStart[link.to + 1]++;
+    }
+    for (int p = 0; p < count; p++) {
+        incomingStart[p + 1] += incomingStart[p];
+    }
+    incoming.resize(links.size());
+    std::vector<int> fill(incomingStart.begin(), incomingStart.end() - 1);
+    for (int l = 0; l < getLinkCount(); l++) {
+        incoming[fill[links[l].to]++] = l;
+    }
+}
+
+void NavGraph::addWalkLinks(int from, int to) {
+    const SDL_Rect& a = surfaces[from];
+    const SDL_Rect& b = surfaces[to];
+    if (a.y != b.y || b.x > a.x + a.w || b.x + b.w < a.x) return;
+
+    int landing = std::max(b.x, b.x + b.w / 2 - profile.width / 2);
+    addLink(from, to, LinkType::WALK, b.x > a.x ? 1 : -1, landing, landing);
+}
+
+void NavGraph::addJumpLinks(int from, int to, int stageWidth) {
+    const SDL_Rect& a = surfaces[from];
+    const SDL_Rect& b = surfaces[to];
+    int rise = a.y - b.y;
+    if (rise < 0) return;
+
+    int upTicks, landTicks;
+    if (!jumpTicks(rise, upTicks, landTicks)) return;
+
+    // Takeoff spots that still stand on a, and landings with at least half
+    // the body over b
+    const int width = profile.width;
+    int minX = std::max(a.x - width + 1, 0);
+    int maxX = std::min(a.x + a.w - 1, stageWidth - width);
+    int landMin = b.x - width / 2;
+    int landMax = b.x + b.w - width / 2;
+    int rightmost = std::max(b.x, b.x + b.w - width);
+
+    // Take off as close as possible while staying clear of b's underside
+    // until the feet are above it
+    int takeoff = std::min(maxX, b.x - width - reach(upTicks));
+    if (takeoff >= minX && takeoff + reach(landTicks) >= landMin) {
+        int landing = std::min(std::max(takeoff + reach(landTicks), b.x), rightmost);
+        addLink(from, to, LinkType::JUMP, 1, takeoff, landing);
+    }
+
+    takeoff = std::max(minX, b.x + b.w + reach(upTicks));
+    if (takeoff <= maxX && takeoff - reach(landTicks) <= landMax) {
+        int landing = std::min(std::max(takeoff - reach(landTicks), b.x), rightmost);
+        addLink(from, to, LinkType::JUMP, -1, takeoff, landing);
+    }
+}
+
+void NavGraph::addDropLinks(int from, int stageWidth) {
+    const SDL_Rect& a = surfaces[from];
+    const int width = profile.width;
+
+    for (int direction = -1; direction <= 1; direction += 2) {
+        int takeoff = direction > 0 ? a.x + a.w : a.x - width;
+        if (takeoff < 0 || takeoff + width > stageWidth) continue;
+
+        // Every platform below we could steer onto, nearest first
+        std::vector<std::pair<int, int>> candidates;
+        for (int to = 0; to < getPlatformCount(); to++) {
+            const SDL_Rect& b = surfaces[to];
+            int drop = b.y - a.y;
+            if (drop <= 0) continue;
+
+            // Check the side first, it's cheaper than stepping the fall
+            int landMin = b.x - width / 2;
+            int landMax = b.x + b.w - width / 2;
+            if (direction > 0 ? landMax < takeoff : landMin > takeoff) continue;
+
+            int fallReach = reach(fallTicks(drop));
+            if (direction > 0 ? landMin <= takeoff + fallReach : landMax >= takeoff - fallReach) {
+                candidates.push_back({b.y, to});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // Skip platforms whose fall passes through a nearer one, which
+        // would catch the body first
+        std::vector<int> accepted;
+        for (const auto& candidate : candidates) {
+            const SDL_Rect& b = surfaces[candidate.second];
+            int landing = std::min(std::max(takeoff, b.x), std::max(b.x, b.x + b.w - width));
+            int left = std::min(takeoff, landing);
+            int right = std::max(takeoff, landing) + width;
+
+            bool blocked = false;
+            for (int other : accepted) {
+                const SDL_Rect& c = surfaces[other];
+                if (c.y < b.y && c.x < right && c.x + c.w > left) {
+                    blocked = true;
+                    break;
+                }
+            }
+            if (!blocked) {
+                addLink(from, candidate.second, LinkType::DROP, direction, takeoff, landing);
+                accepted.push_back(candidate.second);
+            }
+        }
+    }
+}
+
+void NavGraph::addLink(int from, int to, LinkType type, int direction, int takeoffX, int landingX) {
+    int cost = std::abs(landingX - takeoffX) + std::abs(surfaces[to].y - surfaces[from].y);
+    if (type == LinkType::JUMP) {
+        cost += JUMP_COST;
+    }
+    links.push_back({from, to, type, direction, takeoffX, landingX, cost});
+}
+
+bool NavGraph::jumpTicks(int rise, int& upTicks, int& landTicks) const {
+    // Same integration as the simulation, measured upward from the takeoff
+    Scalar height = 0;
+    Scalar speed = -profile.jumpForce;
+    upTicks = -1;
+    if (rise >= maxRise) return false;
+    for (int tick = 1; tick <= MAX_AIR_TICKS; tick++) {
+        speed -= profile.gravity;
+        height += speed;
+        if (upTicks < 0) {
+            if (height > Scalar(rise)) {
+                upTicks = tick;
+            } else if (speed <= Scalar(0)) {
+                return false;
+            }
+        } else if (speed < Scalar(0) && height <= Scalar(rise)) {
+            landTicks = tick;
+            return true;
+        }
+    }
+    return false;
+}
+
+int NavGraph::fallTicks(int drop) const {
+    // First tick whose fall distance covers the drop
+    auto it = std::lower_bound(fallDistance.begin(), fallDistance.end(), drop);
+    return static_cast<int>(it - fallDistance.begin()) + 1;
+}
+
+int NavGraph::reach(int ticks) const {
+    // Horizontal movement starts the tick the decision is made, one tick
+    // before the vertical one
+    return toInt(profile.moveSpeed * Scalar(ticks + 1));
+}
+
+int NavGraph::platformBelow(const SDL_Rect& body) const {
+    int feet = body.y + body.h;
+    int best = -1;
+    for (int p = 0; p < getPlatformCount(); p++) {
+        const SDL_Rect& s = surfaces[p];
+        if (s.x >= body.x + body.w || s.x + s.w <= body.x) continue;
+        if (s.y < feet - SUPPORT_TOLERANCE) continue;
+        if (best < 0 || s.y < surfaces[best].y) {
+            best = p;
+        }
+    }
+    return best;
+}
+
+void NavGraph::searchTo(int target, std::vector<int>& next, FrameArena& scratch) const {
+    const int count = getPlatformCount();
+    next.assign(count, -1);
+    if (target < 0 || target >= count) return;
+
+    // Dijkstra backward from the target along incoming links, so one search
+    // answers every starting platform. Every link improves a cost at most
+    // once, so the open list never holds more than one item per link plus
+    // the target, and it all lives in the frame arena.
+    int* cost = scratch.allocate<int>(count);
+    std::fill(cost, cost + count, INT_MAX);
+    using Item = std::pair<int, int>;
+    Item* open = scratch.allocate<Item>(getLinkCount() + 1);
+    int openCount = 0;
+    cost[target] = 0;
+    open[openCount++] = {0, target};
+
+    while (openCount > 0) {
+        std::pop_heap(open, open + openCount, std::greater<Item>());
+        Item item = open[--openCount];
+        int p = item.second;
+        if (item.first > cost[p]) continue;
+
+        for (int i = incomingStart[p]; i < incomingStart[p + 1]; i++) {
+            const Link& link = links[incoming[i]];
+            int through = item.first + link.cost;
+            if (through < cost[link.from]) {
+                cost[link.from] = through;
+                next[link.from] = incoming[i];
+                open[openCount++] = {through, link.from};
+                std::push_heap(open, open + openCount, std::greater<Item>());
+            }
+        }
+    }
+}
+
+size_t NavGraph::getSearchScratchSize() const {
+    // Both arrays, each with slack for alignment
+    return getPlatformCount() * sizeof(int) + (getLinkCount() + 1) * sizeof(std::pair<int, int>) + 2 * alignof(std::max_align_t);
+}
+
+void PathCache::prepare(const NavGraph& navGraph, int target, FrameArena& scratch) {
+    if (graph != &navGraph || graphVersion != navGraph.getVersion()) {
+        clear();
+        graph = &navGraph;
+        graphVersion = navGraph.getVersion();
+
+        // Route tables sized once per graph, not as targets come and go
+        for (auto& entry : entries) {
+            entry.next.reserve(navGraph.getPlatformCount());
+        }
+    }
+    if (target < 0) return;
+
+    clock++;
+    Entry* slot = &entries[0];
+    for (auto& entry : entries) {
+        if (entry.target == target) {
+            entry.lastUsed = clock;
+            return;
+        }
+        if (entry.lastUsed < slot->lastUsed) {
+            slot = &entry;
+        }
+    }
+
+    navGraph.searchTo(target, slot->next, scratch);
+    slot->target = target;
+    slot->lastUsed = clock;
+    searches++;
+}
+
+int PathCache::nextLink(int from, int target) const {
+    if (from < 0 || target < 0) return -1;
+    for (const auto& entry : entries) {
+        if (entry.target == target) {
+            return entry.next[from];
+        }
+    }
+    return -1;
+}
+
+void PathCache::clear() {
+    for (auto& entry : entries) {
+        entry.target = -1;
+        entry.lastUsed = 0;
+        entry.next.clear();
+    }
+    graph = nullptr;
+    graphVersion = -1;
+}
@@ -0,0 +1,111 @@
+#include "PlatformGrid.h"
+#include <algorithm>
+#include <climits>
+
+void PlatformGrid::build(const std::vector<Platform>& platforms, int size) {
+    cellSize = size;
+    cellStart.clear();
+    cellItems.clear();
+
+    if (platforms.empty()) {
+        columns = rows = 0;
+        return;
+    }
+
+    // Grid covers the bounding box of all platforms
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (const auto& platform : platforms) {
+        SDL_Rect rect = platform.getRect();
+        minX = std::min(minX, rect.x);
+        minY = std::min(minY, rect.y);
+        maxX = std::max(maxX, rect.x + rect.w);
+        maxY = std::max(maxY, rect.y + rect.h);
+    }
+    originX = minX;
+    originY = minY;
+    columns = (maxX - minX) / cellSize + 1;
+    rows = (maxY - minY) / cellSize + 1;
+
+    // Count platforms per cell, then lay the lists out back to back
+    std::vector<int> counts(columns * rows, 0);
+    for (const auto& platform : platforms) {
+        SDL_Rect rect = platform.getRect();
+        for (int row = rowOf(rect.y); row <= rowOf(rect.y + rect.h - 1); row++) {
+            for (int col = columnOf(rect.x); col <= columnOf(rect.x + rect.w - 1); col++) {
+                counts[row * columns + col]++;
+            }
+        }
+    }
+
+    cellStart.resize(columns * rows + 1);
+    cellStart[0] = 0;
+    for (int c = 0; c < columns * rows; c++) {
+        cellStart[c + 1] = cellStart[c] + counts[c];
+    }
+
+    cellItems.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < static_cast<int>(platforms.size()); i++) {
+        SDL_Rect rect = platforms[i].getRect();
+        for (int row = rowOf(rect.y); row <= rowOf(rect.y + rect.h - 1); row++) {
+            for (int col = columnOf(rect.x); col <= columnOf(rect.x + rect.w - 1); col++) {
+                cellItems[fill[row * columns + col]++] = i;
+            }
+        }
+    }
+}
+
+void PlatformGrid::assign(int size, int x, int y, int gridColumns, int gridRows,
+                          const int* starts, const int* items) {
+    cellSize = size;
+    originX = x;
+    originY = y;
+    columns = gridColumns;
+    rows = gridRows;
+    if (columns * rows == 0) {
+        cellStart.clear();
+        cellItems.clear();
+        return;
+    }
+    cellStart.assign(starts, starts + columns * rows + 1);
+    cellItems.assign(items, items + cellStart.back());
+}
+
+void PlatformGrid::query(const SDL_Rect& area, std::vector<int>& out) const {
+    out.clear();
+    if (columns == 0) return;
+
+    // Areas outside the grid clamp to the border cells; the narrow phase
+    // rejects anything that doesn't actually overlap
+    int firstCol = columnOf(area.x);
+    int lastCol = columnOf(area.x + area.w - 1);
+    int firstRow = rowOf(area.y);
+    int lastRow = rowOf(area.y + area.h - 1);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            int cell = row * columns + col;
+            out.insert(out.end(), cellItems.begin() + cellStart[cell], cellItems.begin() + cellStart[cell + 1]);
+        }
+    }
+
+    // A platform spanning several cells shows up once per cell; callers
+    // also rely on level order to resolve collisions the same way as a
+    // full scan would
+    if (firstRow != lastRow || firstCol != lastCol) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+int PlatformGrid::columnOf(int px) const {
+    int col = (px - originX) / cellSize;
+    if (px < originX) col = 0;
+    return std::min(col, columns - 1);
+}
+
+int PlatformGrid::rowOf(int py) const {
+    int row = (py - originY) / cellSize;
+    if (py < originY) row = 0;
+    return std::min(row, rows - 1);
+}
@@ -1,26 +1,33 @@
 #include "Player.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include "Profiler.h"
 
-Player::Player(int x, int y) 
-    : x(x), y(y), velX(0), velY(0), isJumping(false), 
+Player::Player(int x, int y, Archetype archetype) 
+    : archetype(archetype), x(x), y(y), prevX(x), prevY(y), velX(0), velY(0), isJumping(false), 
       isFacingRight(true), attackFrame(0) {}
 
-void Player::update(const std::vector<Platform>& platforms) {
+void Player::update(const Stage& stage) {
+    PROFILE_ZONE("Player::update");
+    withArchetype(archetype, [&](auto type) { updateAs<decltype(type)::value>(stage); });
+}
+
+template <Archetype A>
+void Player::updateAs(const Stage& stage) {
+    constexpr const FighterStats& fighter = fighterStats<A>();
+
     // Store old position
-    float oldX = x;
-    float oldY = y;
+    prevX = x;
+    prevY = y;
     
     // Apply gravity
-    velY += GRAVITY;
-    
-    // Update position
-    x += velX;
-    y += velY;
+    velY += fighter.gravity;
     
     // Update attack state
     if (isAttacking) {
         attackFrame++;
-        if (attackFrame >= ATTACK_DURATION) {
+        if (attackFrame >= fighter.attack.duration()) {
             isAttacking = false;
             attackFrame = 0;
         }
@@ -34,179 +41,151 @@ void Player::update(const std::vector<Platform>& platforms) {
         }
     }
     
-    // Get player rect
-    SDL_Rect playerRect = getRect();
-    
-    // Check collisions with platforms
-    isJumping = true; // Assume we're jumping until we hit a platform
-    
-    // Continuous collision detection
-    for (const auto& platform : platforms) {
-        SDL_Rect platformRect = platform.getRect();
-        
-        // Check if we're moving down and might collide with platform
-        if (velY > 0) {
-            // Create a rectangle representing the path of movement
-            SDL_Rect pathRect = {
-                static_cast<int>(oldX),
-                static_cast<int>(oldY),
-                WIDTH,
-                static_cast<int>(y - oldY + HEIGHT)
-            };
-            
-            // If the path intersects with the platform
-            if (checkCollision(pathRect, platformRect)) {
-                // We're above the platform
-                y = platformRect.y - HEIGHT;
-                velY = 0;
-                isJumping = false;
-            }
-        }
-        // Check if we're moving up and might collide with platform
-        else if (velY < 0) {
-            SDL_Rect pathRect = {
-                static_cast<int>(oldX),
-                static_cast<int>(y),
-                WIDTH,
-                static_cast<int>(oldY - y + HEIGHT)
-            };
-            
-            if (checkCollision(pathRect, platformRect)) {
-                y = platformRect.y + platformRect.h;
-                velY = 0;
-            }
-        }
-        
-        // Horizontal collision checks
-        if (velX != 0) {
-            SDL_Rect pathRect = {
-                static_cast<int>(velX > 0 ? oldX : x),
-                static_cast<int>(y),
-                static_cast<int>(std::abs(x - oldX) + WIDTH),
-                HEIGHT
-            };
-            
-            if (checkCollision(pathRect, platformRect)) {
-                if (velX > 0) {
-                    x = platformRect.x - WIDTH;
-                } else {
-                    x = platformRect.x + platformRect.w;
-                }
-                velX = 0;
-            }
-        }
-    }
+    // Move through the platforms; we're jumping until we land on one
+    SweptBody body = {x, y, velX, velY, fighter.width, fighter.height};
+    MoveResult moved = collision.move(stage, body, restingOn);
+    restingOn = moved.floor;
+    x = body.x;
+    y = body.y;
+    velX = body.velX;
+    velY = body.velY;
+    isJumping = (moved.contacts & CONTACT_FLOOR) == 0;
     
     // Screen boundaries
     if (x < 0) x = 0;
-    if (x > 750) x = 750; // 800 - WIDTH
+    if (x > stage.width - fighter.width) x = stage.width - fighter.width;
 }
 
-void Player::render(SDL_Renderer* renderer) {
-    // Draw player
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);  // Green color for player
-    SDL_Rect rect = {static_cast<int>(x), static_cast<int>(y), WIDTH, HEIGHT};
-    SDL_RenderFillRect(renderer, &rect);
-    
-    // Draw attack hitbox if attacking
-    if (isAttacking) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);  // Yellow color for attack
-        SDL_Rect attackRect = getAttackRect();
-        SDL_RenderFillRect(renderer, &attackRect);
-    }
+void Player::snapshot(BodySnapshot& body) const {
+    const FighterStats& fighter = stats();
+    body.prevX = toFloat(prevX);
+    body.prevY = toFloat(prevY);
+    body.x = toFloat(x);
+    body.y = toFloat(y);
+    body.width = fighter.width;
+    body.height = fighter.height;
+    body.attacking = isAttacking;
+    body.attackRect = getAttackRect();
 
-    // Draw cooldown indicator
-    if (!canAttack) {
-        // Calculate cooldown progress (0.0 to 1.0)
-        float cooldownProgress = static_cast<float>(attackCooldownTimer) / ATTACK_COOLDOWN;
-        
-        // Draw a small bar above the player
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);  // Red color for cooldown
-        SDL_Rect cooldownBar = {
-            static_cast<int>(x),
-            static_cast<int>(y - 10),
-            static_cast<int>(WIDTH * cooldownProgress),
-            3
-        };
-        SDL_RenderFillRect(renderer, &cooldownBar);
-    }
+    // Cooldown bar shrinks as the next attack gets ready
+    body.barWidth = canAttack ? 0 : (fighter.width * attackCooldownTimer) / fighter.attack.cooldown;
+}
+
+void Player::handleInput(Uint8 buttons) {
+    withArchetype(archetype, [&](auto type) { handleInputAs<decltype(type)::value>(buttons); });
 }
 
-void Player::handleInput(const Uint8* state) {
+template <Archetype A>
+void Player::handleInputAs(Uint8 buttons) {
+    constexpr const FighterStats& fighter = fighterStats<A>();
+
     // Movement
-    if (state[SDL_SCANCODE_LEFT]) {
-        velX = -MOVE_SPEED;
+    if (buttons & INPUT_LEFT) {
+        velX = -fighter.moveSpeed;
         isFacingRight = false;
-    } else if (state[SDL_SCANCODE_RIGHT]) {
-        velX = MOVE_SPEED;
+    } else if (buttons & INPUT_RIGHT) {
+        velX = fighter.moveSpeed;
         isFacingRight = true;
     } else {
         velX = 0;
     }
 
     // Jumping
-    if (state[SDL_SCANCODE_SPACE] && !isJumping) {
-        velY = JUMP_FORCE;
+    if ((buttons & INPUT_JUMP) && !isJumping) {
+        velY = fighter.jumpForce;
         isJumping = true;
     }
 
     // Attacking
-    if (state[SDL_SCANCODE_Z] && canAttack && !isAttacking) {
+    if ((buttons & INPUT_ATTACK) && canAttack && !isAttacking) {
         isAttacking = true;
         attackFrame = 0;
         canAttack = false;
-        attackCooldownTimer = ATTACK_COOLDOWN;
+        attackCooldownTimer = fighter.attack.cooldown;
     }
 }
 
 SDL_Rect Player::getAttackRect() const {
-    // Only return attack rect during the first half of the attack animation
-    if (attackFrame >= ATTACK_DURATION / 2) {
-        return {0, 0, 0, 0};  // Return empty rect if attack is in recovery
+    return withArchetype(archetype, [&](auto type) { return attackRectAs<decltype(type)::value>(); });
+}
+
+template <Archetype A>
+SDL_Rect Player::attackRectAs() const {
+    constexpr const MoveData& attack = fighterStats<A>().attack;
+
+    // Only return attack rect while the hitbox is out
+    if (attackFrame < attack.startup || attackFrame >= attack.startup + attack.active) {
+        return {0, 0, 0, 0};  // Return empty rect during startup and recovery
     }
 
-    int attackX = isFacingRight ? x + WIDTH : x - ATTACK_RANGE;
+    // Offsets mirror about the body when facing left
+    constexpr int mirroredX = fighterStats<A>().width - attack.hitbox.x - attack.hitbox.w;
+    int attackX = toInt(isFacingRight ? x + attack.hitbox.x : x + mirroredX);
     return {
         attackX,
-        static_cast<int>(y),
-        ATTACK_RANGE,
-        HEIGHT
+        toInt(y + attack.hitbox.y),
+        attack.hitbox.w,
+        attack.hitbox.h
     };
 }
 
-bool Player::checkCollision(const SDL_Rect& a, const SDL_Rect& b) const {
-    return (a.x < b.x + b.w &&
-            a.x + a.w > b.x &&
-            a.y < b.y + b.h &&
-            a.y + a.h > b.y);
-}
+void Player::publishBoxes(Combat& combat, Uint32 entity, int frame) const {
+    combat.addHurtbox(getRect(), entity, 0, Team::PLAYERS);
 
-void Player::resolveCollision(const Platform& platform) {
-    SDL_Rect playerRect = getRect();
-    SDL_Rect platformRect = platform.getRect();
-
-    // Calculate overlap on each axis
-    int overlapX = std::min(playerRect.x + playerRect.w - platformRect.x,
-                           platformRect.x + platformRect.w - playerRect.x);
-    int overlapY = std::min(playerRect.y + playerRect.h - platformRect.y,
-                           platformRect.y + platformRect.h - playerRect.y);
-
-    // Resolve collision based on smallest overlap
-    if (overlapX < overlapY) {
-        if (playerRect.x < platformRect.x) {
-            x = platformRect.x - playerRect.w;
-        } else {
-            x = platformRect.x + platformRect.w;
-        }
-        velX = 0;
-    } else {
-        if (playerRect.y < platformRect.y) {
-            y = platformRect.y - playerRect.h;
-            velY = 0;
-        } else {
-            y = platformRect.y + platformRect.h;
-            velY = 0;
-            isJumping = false;
+    // An attack is named by the frame it started on
+    if (isAttacking) {
+        SDL_Rect attackRect = getAttackRect();
+        if (attackRect.w > 0) {
+            combat.addHitbox(attackRect, entity, static_cast<Uint32>(frame - attackFrame), Team::PLAYERS,
+                             stats().attack.damage);
         }
     }
-} 
\ No newline at end of file
+}
+
+void Player::saveState(PlayerState& state) const {
+    state.archetype = archetype;
+    state.x = x;
+    state.y = y;
+    state.prevX = prevX;
+    state.prevY = prevY;
+    state.velX = velX;
+    state.velY = velY;
+    state.attackFrame = attackFrame;
+    state.attackCooldownTimer = attackCooldownTimer;
+    state.isJumping = isJumping;
+    state.isFacingRight = isFacingRight;
+    state.isAttacking = isAttacking;
+    state.canAttack = canAttack;
+}
+
+void Player::hashState(StateHash& hash) const {
+    hash.add(static_cast<Uint8>(archetype));
+    hash.add(x);
+    hash.add(y);
+    hash.add(prevX);
+    hash.add(prevY);
+    hash.add(velX);
+    hash.add(velY);
+    hash.add(attackFrame);
+    hash.add(attackCooldownTimer);
+    hash.add(isJumping);
+    hash.add(isFacingRight);
+    hash.add(isAttacking);
+    hash.add(canAttack);
+}
+
+void Player::loadState(const PlayerState& state) {
+    archetype = state.archetype;
+    x = state.x;
+    y = state.y;
+    prevX = state.prevX;
+    prevY = state.prevY;
+    velX = state.velX;
+    velY = state.velY;
+    attackFrame = state.attackFrame;
+    attackCooldownTimer = state.attackCooldownTimer;
+    isJumping = state.isJumping;
+    isFacingRight = state.isFacingRight;
+    isAttacking = state.isAttacking;
+    canAttack = state.canAttack;
+}
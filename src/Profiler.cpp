@@ -0,0 +1,179 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PF_PROFILE_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PF_PROFILE_TSC
+#endif
+
+struct ZoneRecord {
+    Uint64 start;
+    Uint32 duration;  // Clock ticks, clamped to fit
+    Uint16 zone;
+};
+
+struct ThreadBuffer {
+    int thread;
+    std::vector<ZoneRecord> records;
+    Uint64 written = 0;
+};
+
+// Clock readings taken together at startup, to calibrate ticks against
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+static const Uint64 epochTicks = Profiler::now();
+
+static std::mutex zonesMutex;
+static const char* zoneNames[Profiler::MAX_ZONES];
+static std::atomic<int> zoneCount(0);
+
+// Time spent in each zone this frame, from any thread, and per frame before
+static std::atomic<Uint64> frameTotals[Profiler::MAX_ZONES];
+static Uint64 history[Profiler::MAX_ZONES][Profiler::HISTORY_FRAMES];
+static int historyFrame = 0;
+
+static std::mutex buffersMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+static thread_local ThreadBuffer* localBuffer = nullptr;
+
+static ThreadBuffer* bufferForThisThread() {
+    if (localBuffer) return localBuffer;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.push_back(std::make_unique<ThreadBuffer>());
+    localBuffer = buffers.back().get();
+    localBuffer->thread = static_cast<int>(buffers.size());
+    localBuffer->records.resize(Profiler::BUFFER_CAPACITY);
+    return localBuffer;
+}
+
+int Profiler::registerZone(const char* name) {
+    std::lock_guard<std::mutex> lock(zonesMutex);
+    int count = zoneCount.load(std::memory_order_relaxed);
+    for (int zone = 0; zone < count; zone++) {
+        if (std::string(zoneNames[zone]) == name) return zone;
+    }
+    if (count == MAX_ZONES) return -1;
+
+    zoneNames[count] = name;
+    zoneCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+int Profiler::getZoneCount() {
+    return zoneCount.load(std::memory_order_acquire);
+}
+
+const char* Profiler::getZoneName(int zone) {
+    return zoneNames[zone];
+}
+
+Uint64 Profiler::now() {
+#ifdef PF_PROFILE_TSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+double Profiler::ticksPerMicrosecond() {
+#ifdef PF_PROFILE_TSC
+    // Measured over the whole run so far, no calibration delay at startup
+    double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    Uint64 elapsedTicks = now() - epochTicks;
+    return elapsedUs > 0.0 ? elapsedTicks / elapsedUs : 1.0;
+#else
+    return 1000.0;
+#endif
+}
+
+void Profiler::record(int zone, Uint64 start, Uint64 end) {
+    if (zone < 0) return;
+
+    ThreadBuffer* buffer = bufferForThisThread();
+    Uint64 duration = end - start;
+    buffer->records[buffer->written % BUFFER_CAPACITY] = {
+        start,
+        static_cast<Uint32>(std::min<Uint64>(duration, UINT32_MAX)),
+        static_cast<Uint16>(zone)
+    };
+    buffer->written++;
+
+    frameTotals[zone].fetch_add(duration, std::memory_order_relaxed);
+}
+
+void Profiler::endFrame() {
+    int count = getZoneCount();
+    for (int zone = 0; zone < count; zone++) {
+        history[zone][historyFrame] = frameTotals[zone].exchange(0, std::memory_order_relaxed);
+    }
+    historyFrame = (historyFrame + 1) % HISTORY_FRAMES;
+}
+
+void Profiler::drawOverlay(RenderQueue& queue, int x, int y, int width) {
+    static const SDL_Color palette[] = {
+        {255, 99, 71, 255}, {60, 179, 113, 255}, {65, 105, 225, 255}, {255, 215, 0, 255},
+        {238, 130, 238, 255}, {64, 224, 208, 255}, {255, 165, 0, 255}, {173, 255, 47, 255}
+    };
+    const int rowHeight = 24;
+    const int barWidth = std::max(width / HISTORY_FRAMES, 1);
+
+    int count = getZoneCount();
+    for (int zone = 0; zone < count; zone++) {
+        int top = y + zone * (rowHeight + 2);
+        queue.fillRect(RenderLayer::OVERLAY_BACK, {30, 30, 30, 255}, {x, top, barWidth * HISTORY_FRAMES, rowHeight});
+
+        Uint64 slowest = 1;
+        for (int frame = 0; frame < HISTORY_FRAMES; frame++) {
+            slowest = std::max(slowest, history[zone][frame]);
+        }
+
+        // Oldest frame on the left
+        SDL_Color color = palette[zone % (sizeof(palette) / sizeof(palette[0]))];
+        for (int column = 0; column < HISTORY_FRAMES; column++) {
+            Uint64 value = history[zone][(historyFrame + column) % HISTORY_FRAMES];
+            int height = static_cast<int>(value * rowHeight / slowest);
+            if (height > 0) {
+                queue.fillRect(RenderLayer::OVERLAY, color, {x + column * barWidth, top + rowHeight - height, barWidth, height});
+            }
+        }
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+
+    double ticksPerUs = ticksPerMicrosecond();
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const auto& buffer : buffers) {
+        // Oldest first; a full buffer wrapped around and lost the earliest
+        Uint64 begin = buffer->written > BUFFER_CAPACITY ? buffer->written - BUFFER_CAPACITY : 0;
+        for (Uint64 i = begin; i < buffer->written; i++) {
+            const ZoneRecord& record = buffer->records[i % BUFFER_CAPACITY];
+            file << (first ? "\n" : ",\n") << std::fixed << std::setprecision(3)
+                 << "{\"name\":\"" << zoneNames[record.zone] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread
+                 << ",\"ts\":" << (record.start - epochTicks) / ticksPerUs
+                 << ",\"dur\":" << record.duration / ticksPerUs << "}";
+            first = false;
+        }
+    }
+    file << "\n]}\n";
+
+    std::cout << "Wrote profile to " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,43 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+void RenderQueue::fillRect(RenderLayer layer, SDL_Color color, const SDL_Rect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    Uint64 key = (static_cast<Uint64>(layer) << 32) |
+                 (static_cast<Uint64>(color.r) << 24) |
+                 (static_cast<Uint64>(color.g) << 16) |
+                 (static_cast<Uint64>(color.b) << 8) |
+                 color.a;
+    commands.push_back({key, static_cast<Uint32>(commands.size()), rect});
+}
+
+void RenderQueue::flush(SDL_Renderer* renderer, FrameArena& scratch) {
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        return a.key != b.key ? a.key < b.key : a.order < b.order;
+    });
+
+    drawCalls = 0;
+    SDL_Rect* batch = scratch.allocate<SDL_Rect>(commands.size());
+    size_t i = 0;
+    while (i < commands.size()) {
+        Uint64 key = commands[i].key;
+
+        // Gather the run of rectangles sharing this state
+        int batchSize = 0;
+        while (i < commands.size() && commands[i].key == key) {
+            batch[batchSize++] = commands[i].rect;
+            i++;
+        }
+
+        SDL_SetRenderDrawColor(renderer,
+                               static_cast<Uint8>(key >> 24),
+                               static_cast<Uint8>(key >> 16),
+                               static_cast<Uint8>(key >> 8),
+                               static_cast<Uint8>(key));
+        SDL_RenderFillRects(renderer, batch, batchSize);
+        drawCalls++;
+    }
+
+    commands.clear();
+}
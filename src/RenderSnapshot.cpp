@@ -0,0 +1,49 @@
+#include "RenderSnapshot.h"
+
+// Body rect at its interpolated position, and the offset from its
+// end-of-tick position for anything drawn relative to it
+static SDL_Rect interpolate(const BodySnapshot& body, float alpha, int& offsetX, int& offsetY) {
+    SDL_Rect rect = {
+        static_cast<int>(body.prevX + (body.x - body.prevX) * alpha),
+        static_cast<int>(body.prevY + (body.y - body.prevY) * alpha),
+        body.width,
+        body.height
+    };
+    offsetX = rect.x - static_cast<int>(body.x);
+    offsetY = rect.y - static_cast<int>(body.y);
+    return rect;
+}
+
+static void drawAttack(RenderQueue& queue, const BodySnapshot& body, int offsetX, int offsetY) {
+    if (!body.attacking) return;
+    SDL_Rect attackRect = body.attackRect;
+    attackRect.x += offsetX;
+    attackRect.y += offsetY;
+    queue.fillRect(RenderLayer::EFFECTS, {255, 255, 0, 255}, attackRect);  // Yellow color for attack
+}
+
+void RenderSnapshot::draw(RenderQueue& queue, float alpha) const {
+    if (tick < 0) return;
+    int offsetX, offsetY;
+
+    // Draw enemies that are still alive
+    for (const auto& enemy : enemies) {
+        SDL_Rect rect = interpolate(enemy, alpha, offsetX, offsetY);
+        queue.fillRect(RenderLayer::BODIES, {255, 0, 0, 255}, rect);  // Red color for enemy
+        drawAttack(queue, enemy, offsetX, offsetY);
+
+        // Health bar over a gray background
+        queue.fillRect(RenderLayer::BARS_BACK, {100, 100, 100, 255}, {rect.x, rect.y - 10, enemy.width, 5});
+        queue.fillRect(RenderLayer::BARS, {0, 255, 0, 255}, {rect.x, rect.y - 10, enemy.barWidth, 5});
+    }
+
+    // Draw player
+    SDL_Rect rect = interpolate(player, alpha, offsetX, offsetY);
+    queue.fillRect(RenderLayer::BODIES, {0, 255, 0, 255}, rect);  // Green color for player
+    drawAttack(queue, player, offsetX, offsetY);
+
+    // Cooldown bar while the next attack isn't ready
+    if (player.barWidth > 0) {
+        queue.fillRect(RenderLayer::BARS, {255, 0, 0, 255}, {rect.x, rect.y - 10, player.barWidth, 3});
+    }
+}
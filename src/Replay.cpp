@@ -0,0 +1,107 @@
+#include "Replay.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+void ReplayRecorder::record(Uint8 buttons) {
+    if (!runInputs.empty() && runInputs.back() == buttons) {
+        runLengths.back()++;
+    } else {
+        runInputs.push_back(buttons);
+        runLengths.push_back(1);
+    }
+    frameCount++;
+}
+
+bool ReplayRecorder::save(const std::string& path) const {
+    std::vector<Uint8> out;
+    out.reserve(ReplayFormat::HEADER_SIZE + runInputs.size() * 3);
+
+    out.insert(out.end(), ReplayFormat::MAGIC, ReplayFormat::MAGIC + 4);
+    out.push_back(ReplayFormat::VERSION & 0xFF);
+    out.push_back(ReplayFormat::VERSION >> 8);
+    out.push_back(tickRate & 0xFF);
+    out.push_back(tickRate >> 8);
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back((frameCount >> shift) & 0xFF);
+    }
+
+    for (size_t i = 0; i < runInputs.size(); i++) {
+        out.push_back(runInputs[i]);
+        Uint32 length = runLengths[i];
+        while (length >= 0x80) {
+            out.push_back(static_cast<Uint8>(length | 0x80));
+            length >>= 7;
+        }
+        out.push_back(static_cast<Uint8>(length));
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(out.data()), out.size())) {
+        std::cerr << "Could not write replay " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayPlayer::open(const std::string& path) {
+    if (!file.open(path)) {
+        std::cerr << "Could not open replay " << path << std::endl;
+        return false;
+    }
+
+    const Uint8* data = file.data();
+    if (file.size() < ReplayFormat::HEADER_SIZE ||
+        std::memcmp(data, ReplayFormat::MAGIC, 4) != 0) {
+        std::cerr << path << " is not a replay file" << std::endl;
+        file.close();
+        return false;
+    }
+
+    Uint16 version = data[4] | (data[5] << 8);
+    if (version != ReplayFormat::VERSION) {
+        std::cerr << "Unsupported replay version " << version << std::endl;
+        file.close();
+        return false;
+    }
+
+    tickRate = data[6] | (data[7] << 8);
+    frameCount = data[8] | (data[9] << 8) | (data[10] << 16) | (static_cast<Uint32>(data[11]) << 24);
+    offset = ReplayFormat::HEADER_SIZE;
+    framesPlayed = 0;
+    runRemaining = 0;
+    return true;
+}
+
+bool ReplayPlayer::next(Uint8& buttons) {
+    if (framesPlayed >= frameCount) {
+        return false;
+    }
+
+    // Start the next run
+    if (runRemaining == 0) {
+        const Uint8* data = file.data();
+        if (offset >= file.size()) {
+            return false;
+        }
+        runInput = data[offset++];
+
+        Uint32 length = 0;
+        int shift = 0;
+        while (offset < file.size() && shift < 32) {
+            Uint8 byte = data[offset++];
+            length |= static_cast<Uint32>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+        }
+        if (length == 0) {
+            return false;
+        }
+        runRemaining = length;
+    }
+
+    buttons = runInput;
+    runRemaining--;
+    framesPlayed++;
+    return true;
+}
@@ -0,0 +1,50 @@
+#include "Rollback.h"
+
+Rollback::Rollback(World& world) : world(world) {}
+
+void Rollback::advance(Uint8 buttons) {
+    int slot = frame % HISTORY;
+    world.saveState(snapshots[slot]);
+    inputs[slot] = buttons;
+    world.step(buttons);
+    frame++;
+}
+
+bool Rollback::correctInput(int target, Uint8 buttons) {
+    if (target < getOldestFrame() || target >= frame) {
+        return false;
+    }
+
+    int slot = target % HISTORY;
+    if (inputs[slot] == buttons) {
+        lastResimulated = 0;
+        return true;
+    }
+
+    inputs[slot] = buttons;
+    resimulateFrom(target);
+    return true;
+}
+
+bool Rollback::rollback(int count, const Uint8* correctedInputs) {
+    int from = frame - count;
+    if (count <= 0 || from < getOldestFrame()) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        inputs[(from + i) % HISTORY] = correctedInputs[i];
+    }
+    resimulateFrom(from);
+    return true;
+}
+
+void Rollback::resimulateFrom(int from) {
+    world.loadState(snapshots[from % HISTORY]);
+    for (int f = from; f < frame; f++) {
+        int slot = f % HISTORY;
+        world.saveState(snapshots[slot]);
+        world.step(inputs[slot]);
+    }
+    lastResimulated = frame - from;
+}
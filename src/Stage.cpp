@@ -0,0 +1,134 @@
+#include "Stage.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include "EnemyPool.h"
+
+Stage Stage::builtIn(int width, int height) {
+    Stage stage;
+    stage.width = width;
+    stage.height = height;
+    stage.platforms.push_back(Platform(0, 550, width, 50));  // Ground
+    stage.platforms.push_back(Platform(100, 400, 200, 20)); // Platform 1
+    stage.platforms.push_back(Platform(400, 300, 200, 20)); // Platform 2
+    stage.platforms.push_back(Platform(200, 200, 200, 20)); // Platform 3
+    stage.rebuild();
+
+    stage.playerSpawn = {width/2, height/2};
+    stage.enemySpawns.push_back({150, 350});  // On Platform 1
+    return stage;
+}
+
+void Stage::rebuild() {
+    grid.build(platforms);
+    buildContacts();
+    nav.build(platforms, EnemyPool::navProfile(), width);
+}
+
+// Whether a compiled level's grid is one save() could have written: cell
+// starts running from 0 up to the item count without going back, and every
+// item a platform of the level. Level::open only checks the sections fit.
+static bool gridIsValid(const LevelHeader& header, const Sint32* starts, const Sint32* items) {
+    int cells = header.gridColumns * header.gridRows;
+    if (cells == 0) {
+        return true;
+    }
+    if (header.gridCellSize <= 0 || starts[0] != 0 ||
+        static_cast<Uint32>(starts[cells]) != header.gridItemCount) {
+        return false;
+    }
+    for (int c = 0; c < cells; c++) {
+        if (starts[c + 1] < starts[c]) return false;
+    }
+    for (Uint32 i = 0; i < header.gridItemCount; i++) {
+        if (items[i] < 0 || static_cast<Uint32>(items[i]) >= header.platformCount) return false;
+    }
+    return true;
+}
+
+// Whether a stored link is one NavGraph could have built: between two of
+// the level's platforms, of a known type and direction, with a cost route
+// searches can add up. A route crosses each platform at most once, so
+// capping each cost at INT_MAX / platformCount keeps any route's total
+// from overflowing; negative costs would break the search outright.
+static bool navLinkIsValid(const LevelNavLink& link, Uint32 platformCount) {
+    return link.from >= 0 && static_cast<Uint32>(link.from) < platformCount &&
+           link.to >= 0 && static_cast<Uint32>(link.to) < platformCount &&
+           link.type >= static_cast<Sint32>(NavGraph::LinkType::WALK) &&
+           link.type <= static_cast<Sint32>(NavGraph::LinkType::DROP) &&
+           (link.direction == -1 || link.direction == 1) &&
+           link.cost >= 0 && static_cast<Uint32>(link.cost) <= INT_MAX / std::max<Uint32>(platformCount, 1);
+}
+
+bool Stage::load(const Level& level) {
+    const LevelHeader& header = level.getHeader();
+    width = header.width;
+    height = header.height;
+    playerSpawn = header.playerSpawn;
+
+    const SDL_Rect* rects = level.getPlatforms();
+    platforms.clear();
+    platforms.reserve(header.platformCount);
+    for (Uint32 i = 0; i < header.platformCount; i++) {
+        platforms.emplace_back(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+    }
+
+    const SDL_Point* spawns = level.getEnemySpawns();
+    enemySpawns.assign(spawns, spawns + header.enemySpawnCount);
+
+    if (!gridIsValid(header, level.getGridStarts(), level.getGridItems())) {
+        std::cerr << "Level grid is corrupt or refers to platforms outside the level" << std::endl;
+        return false;
+    }
+    grid.assign(header.gridCellSize, header.gridOriginX, header.gridOriginY,
+                header.gridColumns, header.gridRows, level.getGridStarts(), level.getGridItems());
+    buildContacts();
+
+    // Stored links only hold for enemies that move the way they did when
+    // the level was compiled
+    NavGraph::Profile profile = EnemyPool::navProfile();
+    if (!(header.navProfile == LevelNavProfile::from(profile))) {
+        nav.build(platforms, profile, width);
+        return true;
+    }
+    const LevelNavLink* stored = level.getNavLinks();
+    std::vector<NavGraph::Link> links;
+    links.reserve(header.navLinkCount);
+    for (Uint32 l = 0; l < header.navLinkCount; l++) {
+        const LevelNavLink& link = stored[l];
+        if (!navLinkIsValid(link, header.platformCount)) {
+            std::cerr << "Level navigation link " << l << " is corrupt" << std::endl;
+            return false;
+        }
+        links.push_back({link.from, link.to, static_cast<NavGraph::LinkType>(link.type), link.direction,
+                         link.takeoffX, link.landingX, link.cost});
+    }
+    nav.assign(platforms, profile, std::move(links));
+    return true;
+}
+
+void Stage::buildContacts() {
+    obstructionStart.assign(1, 0);
+    obstructions.clear();
+    std::vector<int> nearby;
+    for (int p = 0; p < static_cast<int>(platforms.size()); p++) {
+        // Anything reaching into the space above the top, or level with
+        // it, out to CONTACT_CLEARANCE past either end. Platforms wholly
+        // below the top are always hit after it, and so never change where
+        // a resting body ends up.
+        SDL_Rect top = platforms[p].getRect();
+        SDL_Rect above = {top.x - CONTACT_CLEARANCE - 2, top.y - CONTACT_CLEARANCE,
+                          top.w + 2 * CONTACT_CLEARANCE + 4, CONTACT_CLEARANCE + 1};
+        grid.query(above, nearby);
+        for (int q : nearby) {
+            SDL_Rect rect = platforms[q].getRect();
+            if (q == p || rect.y > top.y || rect.y + rect.h <= above.y ||
+                rect.x > above.x + above.w || rect.x + rect.w < above.x) {
+                continue;
+            }
+            // Padded by the margin the solver's broadphase bounds add
+            obstructions.push_back({rect.x - 2, rect.x + rect.w + 2, rect.y + rect.h});
+        }
+        obstructionStart.push_back(static_cast<int>(obstructions.size()));
+    }
+}
@@ -0,0 +1,167 @@
+#include "ThreadPool.h"
+
+namespace {
+// Index of the pool worker running on this thread, -1 elsewhere
+thread_local int currentWorker = -1;
+}
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    int index = currentWorker >= 0 ? currentWorker
+                                   : static_cast<int>(nextQueue++ % queues.size());
+    unfinished++;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Publish under the sleep lock so a worker can't miss the wakeup
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued++;
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::function<void()> task;
+    while (unfinished > 0) {
+        // Help out instead of just blocking
+        if (stealTask(currentWorker, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        allDone.wait(lock, [this] { return unfinished == 0 || queued > 0; });
+    }
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentWorker = index;
+    std::function<void()> task;
+
+    while (true) {
+        if (runLoopJob()) {
+            continue;
+        }
+        if (popTask(index, task) || stealTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        workAvailable.wait(lock, [this] { return stopping || queued > 0 || hasLoopJob(); });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::runLoop(int jobCount, void (*invoke)(void*, int), void* context) {
+    if (jobCount <= 0) return;
+
+    // The last loop is finished, so no one can claim from it while its
+    // body changes
+    loopInvoke.store(invoke, std::memory_order_relaxed);
+    loopContext.store(context, std::memory_order_relaxed);
+    loopDone.store(0, std::memory_order_relaxed);
+    uint64_t epoch = (loopState.load(std::memory_order_relaxed) >> (2 * LOOP_JOB_BITS)) + 1;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        loopState.store((epoch << (2 * LOOP_JOB_BITS)) | (static_cast<uint64_t>(jobCount) << LOOP_JOB_BITS),
+                        std::memory_order_release);
+    }
+    workAvailable.notify_all();
+
+    while (runLoopJob()) {}
+    while (loopDone.load(std::memory_order_acquire) < jobCount) {
+        std::this_thread::yield();
+    }
+}
+
+bool ThreadPool::runLoopJob() {
+    uint64_t state = loopState.load(std::memory_order_acquire);
+    while (true) {
+        uint64_t next = state & LOOP_JOB_MASK;
+        uint64_t count = (state >> LOOP_JOB_BITS) & LOOP_JOB_MASK;
+        if (next >= count) {
+            return false;
+        }
+
+        // Only a claim on the state these were read under succeeds
+        void (*invoke)(void*, int) = loopInvoke.load(std::memory_order_relaxed);
+        void* context = loopContext.load(std::memory_order_relaxed);
+        if (loopState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            invoke(context, static_cast<int>(next));
+            loopDone.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::hasLoopJob() const {
+    uint64_t state = loopState.load(std::memory_order_acquire);
+    return (state & LOOP_JOB_MASK) < ((state >> LOOP_JOB_BITS) & LOOP_JOB_MASK);
+}
+
+bool ThreadPool::popTask(int index, std::function<void()>& task) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued--;
+    return true;
+}
+
+bool ThreadPool::stealTask(int thief, std::function<void()>& task) {
+    int count = static_cast<int>(queues.size());
+    int start = thief >= 0 ? thief + 1 : 0;
+    for (int i = 0; i < count; i++) {
+        Queue& queue = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runTask(std::function<void()>& task) {
+    task();
+    task = nullptr;
+
+    if (--unfinished == 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        allDone.notify_all();
+    }
+}
@@ -0,0 +1,148 @@
+#include "World.h"
+#include <algorithm>
+#include <cstring>
+#include "Profiler.h"
+
+World::World(int width, int height, Archetype fighter) : World(Stage::builtIn(width, height), fighter) {}
+
+World::World(const Stage& level, Archetype fighter, int enemyCapacity)
+    : stage(level), player(level.playerSpawn.x, level.playerSpawn.y, fighter),
+      enemies(enemyCapacity),
+      arena(FrameArena::DEFAULT_CAPACITY + level.nav.getSearchScratchSize()) {
+    // Wave 1 is the stage's own spawns, all at once. Spawns past the
+    // pool's capacity are dropped.
+    for (const auto& spawn : stage.enemySpawns) {
+        enemies.spawn(spawn.x, spawn.y);
+    }
+
+    // Size the per-tick lists for a full pool up front
+    int fighters = 1 + enemies.getCapacity();
+    combat.reserve(fighters);
+    hits.reserve(fighters * 2);
+}
+
+void World::step(Uint8 buttons) {
+    PROFILE_ZONE("World::step");
+    player.handleInput(buttons);
+    player.update(stage);
+    SDL_Rect playerRect = player.getRect();
+    enemies.update(stage, &playerRect, 1, frame, arena);
+
+    // Everyone publishes what they can hit and be hit with, then a single
+    // pass finds every hit
+    combat.beginFrame();
+    player.publishBoxes(combat, PLAYER_ENTITY, frame);
+    enemies.publishBoxes(combat, FIRST_ENEMY_ENTITY, frame);
+    hits.clear();
+    combat.resolve(hits, arena);
+
+    for (const auto& hit : hits) {
+        if (eventLog) {
+            eventLog->record<EventType::HIT>(frame, hit.attacker, hit.victim);
+        }
+
+        if (hit.victimTeam == Team::ENEMIES) {
+            int healthBefore = enemies.getHealth(hit.victimSlot);
+            enemies.applyDamage(hit.victimSlot, hit.damage);
+            hitsLanded++;
+            if (eventLog) {
+                int healthAfter = enemies.getHealth(hit.victimSlot);
+                eventLog->record<EventType::DAMAGE>(frame, hit.victim, hit.attacker, healthBefore, healthAfter);
+                if (healthAfter == 0) {
+                    eventLog->record<EventType::DEATH>(frame, hit.victim, hit.attacker);
+                }
+            }
+        } else {
+            hitsTaken++;
+        }
+    }
+
+    updateWaves();
+    frame++;
+
+    // Nothing allocated this tick outlives it
+    arena.reset();
+}
+
+int World::waveSize(int number) const {
+    return std::min(number * static_cast<int>(stage.enemySpawns.size()), enemies.getCapacity());
+}
+
+void World::updateWaves() {
+    if (!wavesEnabled || stage.enemySpawns.empty()) return;
+
+    if (waveSpawnsLeft > 0) {
+        if (--waveTimer > 0) return;
+
+        // The wave started on an empty pool and is no bigger than it, so
+        // there is always a free slot
+        int spawned = waveSize(wave) - waveSpawnsLeft;
+        const SDL_Point& spawn = stage.enemySpawns[spawned % stage.enemySpawns.size()];
+        enemies.spawn(spawn.x, spawn.y);
+        waveSpawnsLeft--;
+        waveTimer = SPAWN_INTERVAL;
+    } else if (isCleared()) {
+        wave++;
+        waveSpawnsLeft = waveSize(wave);
+        waveTimer = WAVE_DELAY;
+    }
+}
+
+void World::setThreadPool(ThreadPool* pool) {
+    enemies.setThreadPool(pool);
+    combat.setThreadPool(pool);
+}
+
+void World::setEventLog(EventLog* log) {
+    eventLog = log;
+    enemies.setEventLog(log, FIRST_ENEMY_ENTITY);
+}
+
+void World::saveState(WorldState& state) const {
+    // Zero padding too, so identical worlds compare equal byte for byte
+    std::memset(static_cast<void*>(&state), 0, sizeof(state));
+    state.frame = frame;
+    state.hitsLanded = hitsLanded;
+    state.hitsTaken = hitsTaken;
+    player.saveState(state.player);
+    state.enemyCount = enemies.saveState(state.enemies, WorldState::MAX_ENEMIES);
+    state.enemySlotCount = enemies.saveSlots(state.enemySlotGenerations, state.freeEnemySlots,
+                                             WorldState::MAX_ENEMIES, state.freeEnemySlotCount);
+    state.wave = wave;
+    state.waveSpawnsLeft = waveSpawnsLeft;
+    state.waveTimer = waveTimer;
+    state.hitRecordCount = combat.saveState(state.hitRecords, WorldState::MAX_HIT_RECORDS);
+}
+
+void World::loadState(const WorldState& state) {
+    frame = state.frame;
+    hitsLanded = state.hitsLanded;
+    hitsTaken = state.hitsTaken;
+    player.loadState(state.player);
+    enemies.loadState(state.enemies, state.enemyCount);
+    enemies.loadSlots(state.enemySlotGenerations, state.enemySlotCount, state.freeEnemySlots, state.freeEnemySlotCount);
+    wave = state.wave;
+    waveSpawnsLeft = state.waveSpawnsLeft;
+    waveTimer = state.waveTimer;
+    combat.loadState(state.hitRecords, state.hitRecordCount);
+}
+
+Uint64 World::hashState() const {
+    StateHash hash;
+    hash.add(frame);
+    hash.add(hitsLanded);
+    hash.add(hitsTaken);
+    player.hashState(hash);
+    enemies.hashState(hash);
+    hash.add(wave);
+    hash.add(waveSpawnsLeft);
+    hash.add(waveTimer);
+    combat.hashState(hash);
+    return hash.get();
+}
+
+void World::snapshot(RenderSnapshot& snapshot) const {
+    snapshot.tick = frame;
+    player.snapshot(snapshot.player);
+    enemies.snapshot(snapshot.enemies);
+}
@@ -1,15 +1,93 @@
 #include "Game.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
 
+// game [--headless [ticks] [seed]] [--level file] [--record file] [--replay file] [--hash-log file] [--events file] [--profile file] [--late-poll] [--fighter name]
 int main(int argc, char* argv[]) {
     Game game;
-    
-    if (!game.init("Platform Fighter", 800, 600)) {
+
+    bool headless = false;
+    int ticks = 100000;
+    Uint32 seed = 1;
+    std::string levelPath;
+    std::string recordPath;
+    std::string replayPath;
+    std::string hashLogPath;
+    std::string eventsPath;
+    std::string profilePath;
+    bool latePolling = false;
+    Archetype fighter = Archetype::BRAWLER;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') ticks = std::atoi(argv[++i]);
+            if (i + 1 < argc && argv[i + 1][0] != '-') seed = static_cast<Uint32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            levelPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--hash-log") == 0 && i + 1 < argc) {
+            hashLogPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            eventsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--late-poll") == 0) {
+            latePolling = true;
+        } else if (std::strcmp(argv[i], "--fighter") == 0 && i + 1 < argc) {
+            if (!archetypeFromName(argv[++i], fighter)) {
+                std::cerr << "Unknown fighter: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    game.setFighter(fighter);
+    bool initialized = headless ? game.initHeadless(800, 600)
+                                : game.init("Platform Fighter", 800, 600);
+    if (!initialized) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return 1;
     }
-    
-    game.run();
-    
+
+    if (!levelPath.empty() && !game.loadLevel(levelPath)) {
+        return 1;
+    }
+
+    // Events go to stdout unless a file was given
+    if (!game.startEventLog(eventsPath)) {
+        return 1;
+    }
+    if (!recordPath.empty()) {
+        game.startRecording(recordPath);
+    }
+    if (!replayPath.empty() && !game.startReplay(replayPath)) {
+        return 1;
+    }
+    if (!hashLogPath.empty()) {
+        game.startHashLog(hashLogPath);
+    }
+
+    if (headless) {
+        // A replay decides its own length
+        game.runHeadless(replayPath.empty() ? ticks : INT32_MAX, seed);
+    } else {
+        game.setLatePolling(latePolling);
+        game.run();
+    }
+
+    if (!profilePath.empty()) {
+        Profiler::writeChromeTrace(profilePath);
+    }
+
     return 0;
 }
@@ -0,0 +1,276 @@
+// Finds where two runs of the same match parted. Compares two hash logs
+// (game --hash-log), bisects their chained hashes for the first frame whose
+// state differs, then re-simulates both logs' inputs locally up to that
+// frame and prints every field of the two world states that differs.
+// Usage: desync_bisect a.pfh b.pfh [--level file]
+//
+// The logs must come from the same stage: pass the level file both runs
+// played, or nothing for the default stage.
+#include "HashLog.h"
+#include "Level.h"
+#include "StateHash.h"
+#include "World.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Prints the fields that differ between two states, one per line
+class FieldDiff {
+public:
+    int getCount() const { return count; }
+
+    void field(const std::string& name, int a, int b) {
+        if (a != b) print(name, std::to_string(a), std::to_string(b));
+    }
+    void field(const std::string& name, Uint32 a, Uint32 b) {
+        if (a != b) print(name, std::to_string(a), std::to_string(b));
+    }
+    void field(const std::string& name, bool a, bool b) {
+        if (a != b) print(name, a ? "true" : "false", b ? "true" : "false");
+    }
+    void field(const std::string& name, Scalar a, Scalar b) {
+        if (scalarBits(a) != scalarBits(b)) print(name, scalarText(a), scalarText(b));
+    }
+
+private:
+    int count = 0;
+
+    void print(const std::string& name, const std::string& a, const std::string& b) {
+        std::cout << "  " << std::left << std::setw(32) << name << std::right
+                  << std::setw(28) << a << "  vs " << b << std::endl;
+        count++;
+    }
+
+    // Value and exact bits, since runs can differ in the last bit only
+    static std::string scalarText(Scalar value) {
+        std::ostringstream text;
+        text << std::setprecision(9) << toFloat(value) << " (0x" << std::hex
+             << std::setw(8) << std::setfill('0') << scalarBits(value) << ")";
+        return text.str();
+    }
+};
+
+static void diffPlayer(FieldDiff& diff, const PlayerState& a, const PlayerState& b) {
+    diff.field("player.archetype", static_cast<int>(a.archetype), static_cast<int>(b.archetype));
+    diff.field("player.x", a.x, b.x);
+    diff.field("player.y", a.y, b.y);
+    diff.field("player.prevX", a.prevX, b.prevX);
+    diff.field("player.prevY", a.prevY, b.prevY);
+    diff.field("player.velX", a.velX, b.velX);
+    diff.field("player.velY", a.velY, b.velY);
+    diff.field("player.attackFrame", a.attackFrame, b.attackFrame);
+    diff.field("player.attackCooldownTimer", a.attackCooldownTimer, b.attackCooldownTimer);
+    diff.field("player.isJumping", a.isJumping, b.isJumping);
+    diff.field("player.isFacingRight", a.isFacingRight, b.isFacingRight);
+    diff.field("player.isAttacking", a.isAttacking, b.isAttacking);
+    diff.field("player.canAttack", a.canAttack, b.canAttack);
+}
+
+static void diffEnemy(FieldDiff& diff, int index, const EnemyState& a, const EnemyState& b) {
+    std::string prefix = "enemies[" + std::to_string(index) + "].";
+    diff.field(prefix + "id", a.id, b.id);
+    diff.field(prefix + "x", a.x, b.x);
+    diff.field(prefix + "y", a.y, b.y);
+    diff.field(prefix + "prevX", a.prevX, b.prevX);
+    diff.field(prefix + "prevY", a.prevY, b.prevY);
+    diff.field(prefix + "velocityX", a.velocityX, b.velocityX);
+    diff.field(prefix + "velocityY", a.velocityY, b.velocityY);
+    diff.field(prefix + "health", a.health, b.health);
+    diff.field(prefix + "attackCooldownTimer", a.attackCooldownTimer, b.attackCooldownTimer);
+    diff.field(prefix + "attackFrame", a.attackFrame, b.attackFrame);
+    diff.field(prefix + "currentPlatform", a.currentPlatform, b.currentPlatform);
+    diff.field(prefix + "navLink", a.navLink, b.navLink);
+    diff.field(prefix + "leftBound", a.leftBound, b.leftBound);
+    diff.field(prefix + "rightBound", a.rightBound, b.rightBound);
+    diff.field(prefix + "currentState", static_cast<int>(a.currentState), static_cast<int>(b.currentState));
+    diff.field(prefix + "grounded", a.grounded, b.grounded);
+    diff.field(prefix + "facingRight", a.facingRight, b.facingRight);
+    diff.field(prefix + "attacking", a.attacking, b.attacking);
+}
+
+static void diffWorld(FieldDiff& diff, const WorldState& a, const WorldState& b) {
+    diff.field("frame", a.frame, b.frame);
+    diff.field("hitsLanded", a.hitsLanded, b.hitsLanded);
+    diff.field("hitsTaken", a.hitsTaken, b.hitsTaken);
+    diffPlayer(diff, a.player, b.player);
+
+    diff.field("enemyCount", a.enemyCount, b.enemyCount);
+    for (int i = 0; i < std::min(a.enemyCount, b.enemyCount); i++) {
+        diffEnemy(diff, i, a.enemies[i], b.enemies[i]);
+    }
+
+    diff.field("enemySlotCount", a.enemySlotCount, b.enemySlotCount);
+    for (int i = 0; i < std::min(a.enemySlotCount, b.enemySlotCount); i++) {
+        diff.field("enemySlotGenerations[" + std::to_string(i) + "]", a.enemySlotGenerations[i], b.enemySlotGenerations[i]);
+    }
+    diff.field("freeEnemySlotCount", a.freeEnemySlotCount, b.freeEnemySlotCount);
+    for (int i = 0; i < std::min(a.freeEnemySlotCount, b.freeEnemySlotCount); i++) {
+        diff.field("freeEnemySlots[" + std::to_string(i) + "]", a.freeEnemySlots[i], b.freeEnemySlots[i]);
+    }
+
+    diff.field("wave", a.wave, b.wave);
+    diff.field("waveSpawnsLeft", a.waveSpawnsLeft, b.waveSpawnsLeft);
+    diff.field("waveTimer", a.waveTimer, b.waveTimer);
+
+    diff.field("hitRecordCount", a.hitRecordCount, b.hitRecordCount);
+    for (int i = 0; i < std::min(a.hitRecordCount, b.hitRecordCount); i++) {
+        std::string prefix = "hitRecords[" + std::to_string(i) + "].";
+        diff.field(prefix + "attacker", a.hitRecords[i].attacker, b.hitRecords[i].attacker);
+        diff.field(prefix + "attack", a.hitRecords[i].attack, b.hitRecords[i].attack);
+        diff.field(prefix + "victim", a.hitRecords[i].victim, b.hitRecords[i].victim);
+    }
+}
+
+// First frame whose chained hash differs between the logs, or -1 if they
+// agree for as long as both run
+static int firstDivergence(const HashLog& a, const HashLog& b) {
+    int common = static_cast<int>(std::min(a.getFrameCount(), b.getFrameCount()));
+    if (common == 0 || a.getHash(common - 1) == b.getHash(common - 1)) {
+        return -1;
+    }
+
+    int low = 0;
+    int high = common - 1;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (a.getHash(middle) != b.getHash(middle)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+// Step a fresh world through log's inputs up to and including frame, and
+// return the first frame whose hash didn't match the log's, or -1
+static int resimulate(World& world, const HashLog& log, int frame) {
+    Uint64 chain = 0;
+    int mismatch = -1;
+    for (int f = 0; f <= frame; f++) {
+        world.step(log.getInput(f));
+        chain = StateHash::chain(chain, world.hashState());
+        if (mismatch < 0 && chain != log.getHash(f)) {
+            mismatch = f;
+        }
+    }
+    return mismatch;
+}
+
+static void reportReproduction(const char* name, int mismatch) {
+    std::cout << "This build reproduces log " << name << ": ";
+    if (mismatch < 0) {
+        std::cout << "yes" << std::endl;
+    } else {
+        std::cout << "no, from frame " << mismatch << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string paths[2];
+    int pathCount = 0;
+    std::string levelPath;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            levelPath = argv[++i];
+        } else if (argv[i][0] != '-' && pathCount < 2) {
+            paths[pathCount++] = argv[i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (pathCount != 2) {
+        std::cerr << "Usage: desync_bisect a.pfh b.pfh [--level file]" << std::endl;
+        return 1;
+    }
+
+    HashLog a, b;
+    if (!a.open(paths[0]) || !b.open(paths[1])) {
+        return 1;
+    }
+
+#ifdef PF_FIXED_POINT
+    const bool fixedPoint = true;
+#else
+    const bool fixedPoint = false;
+#endif
+    if (a.isFixedPoint() != b.isFixedPoint()) {
+        std::cout << "Logs come from float and fixed-point builds; their hashes can't match" << std::endl;
+    }
+
+    std::cout << "A: " << paths[0] << ", " << a.getFrameCount() << " frames, " << FIGHTERS[static_cast<int>(a.getFighter())].name
+              << (a.hasWaves() ? ", waves" : "") << std::endl;
+    std::cout << "B: " << paths[1] << ", " << b.getFrameCount() << " frames, " << FIGHTERS[static_cast<int>(b.getFighter())].name
+              << (b.hasWaves() ? ", waves" : "") << std::endl;
+
+    int frame = firstDivergence(a, b);
+    if (frame < 0) {
+        std::cout << "Logs agree for all " << std::min(a.getFrameCount(), b.getFrameCount()) << " common frames" << std::endl;
+        return 0;
+    }
+    std::cout << "First diverging frame: " << frame << std::endl;
+
+    // A desync caused by different inputs shows up before or at the frame
+    // they first differ
+    for (int f = 0; f <= frame; f++) {
+        if (a.getInput(f) != b.getInput(f)) {
+            std::cout << "Inputs first differ at frame " << f << ": " << static_cast<int>(a.getInput(f))
+                      << " vs " << static_cast<int>(b.getInput(f)) << std::endl;
+            break;
+        }
+    }
+
+    // Re-simulate both sides. Each world is only comparable to its log if
+    // this tool was built the way the log's game was.
+    std::unique_ptr<Stage> stage;
+    if (!levelPath.empty()) {
+        Level file;
+        if (!file.open(levelPath)) {
+            return 1;
+        }
+        stage = std::make_unique<Stage>();
+        if (!stage->load(file)) {
+            return 1;
+        }
+    }
+    // Set up the way the log's game was, or the replay parts ways with it
+    // at the first thing those options change
+    auto makeWorld = [&](const HashLog& log) {
+        auto world = stage ? std::make_unique<World>(*stage, log.getFighter())
+                           : std::make_unique<World>(800, 600, log.getFighter());
+        world->setWaves(log.hasWaves());
+        return world;
+    };
+    auto worldA = makeWorld(a);
+    auto worldB = makeWorld(b);
+    int mismatchA = resimulate(*worldA, a, frame);
+    int mismatchB = resimulate(*worldB, b, frame);
+
+    if (a.isFixedPoint() != fixedPoint || b.isFixedPoint() != fixedPoint) {
+        std::cout << "Note: this tool is a " << (fixedPoint ? "fixed-point" : "float")
+                  << " build; rebuild it to match the logs to reproduce them" << std::endl;
+    }
+    reportReproduction("A", mismatchA);
+    reportReproduction("B", mismatchB);
+
+    auto stateA = std::make_unique<WorldState>();
+    auto stateB = std::make_unique<WorldState>();
+    worldA->saveState(*stateA);
+    worldB->saveState(*stateB);
+
+    std::cout << std::endl << "State after frame " << frame << ", A vs B:" << std::endl;
+    FieldDiff diff;
+    diffWorld(diff, *stateA, *stateB);
+    if (diff.getCount() == 0) {
+        // Same inputs, same local result: the difference came from outside
+        // the inputs, such as a different build, platform or stage, or
+        // state the simulation reads but doesn't hash
+        std::cout << "  (none - both logs' inputs give the same state in this build)" << std::endl;
+    }
+    return 1;
+}
@@ -0,0 +1,84 @@
+// Compiles a text level description into the binary level format the game
+// maps directly (see Level.h), building the platform grid and enemy
+// navigation graph ahead of time.
+// Usage: level_compiler input.txt output.level
+//
+// One entry per line, '#' starts a comment:
+//   bounds   width height
+//   player   x y
+//   enemy    x y
+//   platform x y width height
+#include "Level.h"
+#include "Stage.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static bool parseLevel(std::istream& in, const std::string& name, Stage& stage) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) continue;
+
+        bool ok = false;
+        if (keyword == "bounds") {
+            ok = static_cast<bool>(fields >> stage.width >> stage.height) && stage.width > 0 && stage.height > 0;
+        } else if (keyword == "player") {
+            ok = static_cast<bool>(fields >> stage.playerSpawn.x >> stage.playerSpawn.y);
+        } else if (keyword == "enemy") {
+            SDL_Point spawn;
+            ok = static_cast<bool>(fields >> spawn.x >> spawn.y);
+            if (ok) stage.enemySpawns.push_back(spawn);
+        } else if (keyword == "platform") {
+            int x, y, w, h;
+            ok = static_cast<bool>(fields >> x >> y >> w >> h) && w > 0 && h > 0;
+            if (ok) stage.platforms.push_back(Platform(x, y, w, h));
+        }
+
+        std::string extra;
+        if (!ok || fields >> extra) {
+            std::cerr << name << ":" << lineNumber << ": can't read '" << line << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: level_compiler input.txt output.level" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "Could not open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Stage stage;
+    if (!parseLevel(in, argv[1], stage)) {
+        return 1;
+    }
+    stage.rebuild();
+    if (!Level::save(argv[2], stage)) {
+        return 1;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Compiled " << stage.platforms.size() << " platforms and " << stage.enemySpawns.size()
+              << " enemy spawns into " << argv[2] << " in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    return 0;
+}
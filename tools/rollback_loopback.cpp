@@ -0,0 +1,169 @@
+// Local loopback harness for rollback. A scripted "remote" player sends its
+// inputs through a simulated link with latency and packet loss; the local
+// side predicts missing inputs, rolls back when the real ones arrive and
+// must end up bit-identical to a reference run that had every input on time.
+// Usage: rollback_loopback [frames] [latency frames] [loss %] [seed]
+#include "FrameStats.h"
+#include "Input.h"
+#include "Rollback.h"
+#include "World.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Every packet repeats the last few inputs so a single drop costs nothing
+constexpr int INPUTS_PER_PACKET = 8;
+
+struct Packet {
+    int deliverAt;
+    int firstFrame;
+    int count;
+    Uint8 inputs[INPUTS_PER_PACKET];
+};
+
+}
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 3600;
+    int latency = argc > 2 ? std::atoi(argv[2]) : 4;
+    int lossPercent = argc > 3 ? std::atoi(argv[3]) : 10;
+    Uint32 seed = argc > 4 ? static_cast<Uint32>(std::strtoul(argv[4], nullptr, 10)) : 1;
+
+    // The remote player's real inputs
+    InputScript script(seed);
+    std::vector<Uint8> remoteInputs(frames);
+    for (int f = 0; f < frames; f++) {
+        remoteInputs[f] = script.next();
+    }
+
+    // Reference run with every input known in advance
+    auto reference = std::make_unique<World>(800, 600);
+    for (int f = 0; f < frames; f++) {
+        reference->step(remoteInputs[f]);
+    }
+
+    auto world = std::make_unique<World>(800, 600);
+    auto rollback = std::make_unique<Rollback>(*world);
+
+    std::deque<Packet> link;
+    std::vector<bool> confirmed(frames, false);
+    int firstUnconfirmed = 0;
+    Uint8 lastConfirmed = 0;
+    Uint32 lossRng = seed * 2654435761u + 1;
+
+    FrameStats rollbackMs(100000);
+    int rollbacks = 0;
+    int maxResimulated = 0;
+    int stalls = 0;
+
+    for (int tick = 0; rollback->getFrame() < frames || firstUnconfirmed < frames; tick++) {
+        // Remote sends its newest inputs, unless the packet is lost
+        int sent = std::min(tick + 1, frames);
+        lossRng ^= lossRng << 13;
+        lossRng ^= lossRng >> 17;
+        lossRng ^= lossRng << 5;
+        if (tick < frames && static_cast<int>(lossRng % 100) >= lossPercent) {
+            Packet packet;
+            packet.deliverAt = tick + latency;
+            packet.count = std::min(sent, INPUTS_PER_PACKET);
+            packet.firstFrame = sent - packet.count;
+            std::memcpy(packet.inputs, &remoteInputs[packet.firstFrame], packet.count);
+            link.push_back(packet);
+        } else if (tick >= frames) {
+            // Once the match is over, resend until everything is confirmed
+            Packet packet;
+            packet.deliverAt = tick + latency;
+            packet.firstFrame = firstUnconfirmed;
+            packet.count = std::min(frames - firstUnconfirmed, INPUTS_PER_PACKET);
+            std::memcpy(packet.inputs, &remoteInputs[packet.firstFrame], packet.count);
+            link.push_back(packet);
+        }
+
+        // Receive whatever has arrived and correct past frames
+        int correctFrom = -1;
+        while (!link.empty() && link.front().deliverAt <= tick) {
+            const Packet& packet = link.front();
+            for (int i = 0; i < packet.count; i++) {
+                int f = packet.firstFrame + i;
+                if (confirmed[f]) continue;
+                confirmed[f] = true;
+                if (f < rollback->getFrame()) {
+                    correctFrom = correctFrom < 0 ? f : std::min(correctFrom, f);
+                }
+            }
+            link.pop_front();
+        }
+        while (firstUnconfirmed < frames && confirmed[firstUnconfirmed]) {
+            lastConfirmed = remoteInputs[firstUnconfirmed];
+            firstUnconfirmed++;
+        }
+
+        // Only roll back if a prediction turned out wrong
+        while (correctFrom >= 0 && correctFrom < rollback->getFrame() &&
+               rollback->getInput(correctFrom) == (confirmed[correctFrom] ? remoteInputs[correctFrom] : lastConfirmed)) {
+            correctFrom++;
+        }
+        if (correctFrom >= 0 && correctFrom < rollback->getFrame()) {
+            int count = rollback->getFrame() - correctFrom;
+            std::vector<Uint8> corrected(count);
+            for (int i = 0; i < count; i++) {
+                int f = correctFrom + i;
+                corrected[i] = confirmed[f] ? remoteInputs[f] : lastConfirmed;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            if (!rollback->rollback(count, corrected.data())) {
+                std::cerr << "Input for frame " << correctFrom << " arrived outside the rollback window" << std::endl;
+                return 1;
+            }
+            auto end = std::chrono::steady_clock::now();
+            rollbackMs.add(std::chrono::duration<double, std::milli>(end - start).count());
+            rollbacks++;
+            maxResimulated = std::max(maxResimulated, count);
+        }
+
+        if (rollback->getFrame() >= frames) continue;
+
+        // Don't run so far ahead that unconfirmed input leaves the window
+        if (rollback->getFrame() - firstUnconfirmed >= Rollback::HISTORY - 1) {
+            stalls++;
+            continue;
+        }
+
+        // Predict the remote player keeps doing what they last did
+        int f = rollback->getFrame();
+        rollback->advance(confirmed[f] ? remoteInputs[f] : lastConfirmed);
+    }
+
+    WorldState expected, actual;
+    reference->saveState(expected);
+    world->saveState(actual);
+    bool matches = std::memcmp(&expected, &actual, sizeof(WorldState)) == 0;
+
+    // Cost of snapshot + restore + an 8 frame resimulation
+    const int timingRuns = 1000;
+    Uint8 replay[8];
+    for (int i = 0; i < 8; i++) replay[i] = remoteInputs[frames - 8 + i];
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < timingRuns; i++) {
+        rollback->rollback(8, replay);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double eightFrameUs = std::chrono::duration<double, std::micro>(end - start).count() / timingRuns;
+
+    std::cout << "Frames: " << frames << "  latency: " << latency << " frames  loss: " << lossPercent << "%" << std::endl;
+    std::cout << "Rollbacks: " << rollbacks << "  max resimulated: " << maxResimulated
+              << " frames  stalls: " << stalls << std::endl;
+    std::cout << "Rollback ms  mean " << rollbackMs.mean() << "  p99 " << rollbackMs.p99()
+              << "  max " << rollbackMs.max() << std::endl;
+    std::cout << "8-frame rollback: " << eightFrameUs << " us" << std::endl;
+    std::cout << "State matches reference: " << (matches ? "yes" : "NO") << std::endl;
+
+    return matches ? 0 : 1;
+}